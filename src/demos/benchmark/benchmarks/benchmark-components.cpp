@@ -0,0 +1,170 @@
+#include "benchmark-components.h"
+
+#include <suprengine/core/component-registry.h>
+#include <suprengine/core/component-scheduler.h>
+#include <suprengine/core/entity.h>
+#include <suprengine/core/job-system.h>
+
+#include <chrono>
+
+using namespace benchmark;
+using namespace suprengine;
+
+namespace chrono = std::chrono;
+
+//	Amount of updates to average the results on
+constexpr int FRAMES_COUNT = 30;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+constexpr int ENTITIES_COUNTS[] { 10'000, 100'000, 1'000'000 };
+
+class VelocityComponent : public Component
+{
+public:
+	VelocityComponent( const Vec3& velocity )
+		: velocity( velocity ) {}
+
+	void update( float dt ) override
+	{
+		transform->set_location( transform->location + velocity * dt );
+	}
+
+public:
+	Vec3 velocity = Vec3::zero;
+};
+
+class ParallelVelocityComponent : public VelocityComponent
+{
+public:
+	ParallelVelocityComponent( const Vec3& velocity )
+		: VelocityComponent( velocity ) {}
+
+	const ComponentAccess* get_update_access() const override
+	{
+		static const ComponentAccess access =
+			ComponentAccess::of<ParallelVelocityComponent>().write<Transform>();
+		return &access;
+	}
+};
+
+struct LocationData
+{
+	Vec3 value = Vec3::zero;
+};
+
+struct VelocityData
+{
+	Vec3 value = Vec3::zero;
+};
+
+static void print_result( const char* name, const int entities_count, const chrono::steady_clock::duration& duration )
+{
+	const double total_ms = chrono::duration<double, std::milli>( duration ).count();
+	const double frame_ms = total_ms / FRAMES_COUNT;
+	const double entity_ns = frame_ms * 1'000'000.0 / entities_count;
+
+	printf(
+		"Benchmark: %-10s %8d entities: %9.3fms/frame (%.2fns/entity)\n",
+		name, entities_count, frame_ms, entity_ns
+	);
+}
+
+void BenchmarkComponents::run()
+{
+	for ( const int entities_count : ENTITIES_COUNTS )
+	{
+		_run_entities( entities_count );
+		_run_parallel( entities_count );
+		_run_registry( entities_count );
+	}
+}
+
+void BenchmarkComponents::_run_entities( const int entities_count )
+{
+	//	Setup standalone entities, as there is no engine: they aren't pooled
+	//	nor added to the engine, so they aren't in its tick lists
+	std::vector<SharedPtr<Entity>> entities {};
+	entities.reserve( entities_count );
+	for ( int i = 0; i < entities_count; i++ )
+	{
+		SharedPtr<Entity> entity( new Entity() );
+		entity->init();
+		entity->create_component<VelocityComponent>( Vec3 { 1.0f, 2.0f, 3.0f } );
+		entities.push_back( entity );
+	}
+
+	//	Update the components of each entity in turn through Entity::update.
+	//	NOTE: The engine updates components by type through its tick lists
+	//	instead, this measures the per-entity hierarchy as a comparison.
+	const auto start_time = chrono::steady_clock::now();
+	for ( int frame = 0; frame < FRAMES_COUNT; frame++ )
+	{
+		for ( const SharedPtr<Entity>& entity : entities )
+		{
+			if ( entity->state != EntityState::Active ) continue;
+			entity->update( DELTA_TIME );
+		}
+	}
+	const auto end_time = chrono::steady_clock::now();
+
+	print_result( "Entities", entities_count, end_time - start_time );
+}
+
+void BenchmarkComponents::_run_parallel( const int entities_count )
+{
+	JobSystem jobs {};
+	ComponentScheduler scheduler {};
+
+	std::vector<SharedPtr<Entity>> entities {};
+	entities.reserve( entities_count );
+	for ( int i = 0; i < entities_count; i++ )
+	{
+		SharedPtr<Entity> entity( new Entity() );
+		entity->init();
+		entity->create_component<ParallelVelocityComponent>( Vec3 { 1.0f, 2.0f, 3.0f } );
+		entities.push_back( entity );
+	}
+
+	//	Queue components through the entities then update them in parallel
+	const auto start_time = chrono::steady_clock::now();
+	for ( int frame = 0; frame < FRAMES_COUNT; frame++ )
+	{
+		for ( const SharedPtr<Entity>& entity : entities )
+		{
+			if ( entity->state != EntityState::Active ) continue;
+			entity->update( DELTA_TIME, &scheduler );
+		}
+
+		scheduler.update( &jobs, DELTA_TIME );
+	}
+	const auto end_time = chrono::steady_clock::now();
+
+	print_result( "Parallel", entities_count, end_time - start_time );
+}
+
+void BenchmarkComponents::_run_registry( const int entities_count )
+{
+	//	Setup components in the registry with fake handles, as there is no engine
+	ComponentRegistry registry {};
+	for ( int i = 0; i < entities_count; i++ )
+	{
+		const EntityHandle handle { static_cast<uint32>( i ), 1 };
+		registry.add<LocationData>( handle );
+		registry.add<VelocityData>( handle, Vec3 { 1.0f, 2.0f, 3.0f } );
+	}
+
+	//	Update them contiguously
+	const auto start_time = chrono::steady_clock::now();
+	for ( int frame = 0; frame < FRAMES_COUNT; frame++ )
+	{
+		registry.each<VelocityData, LocationData>(
+			[]( EntityHandle, VelocityData& velocity, LocationData& location )
+			{
+				location.value += velocity.value * DELTA_TIME;
+			}
+		);
+	}
+	const auto end_time = chrono::steady_clock::now();
+
+	print_result( "Registry", entities_count, end_time - start_time );
+}
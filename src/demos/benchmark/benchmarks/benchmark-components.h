@@ -0,0 +1,24 @@
+#pragma once
+
+namespace benchmark
+{
+	/*
+	 * Compare the update cost of the Component hierarchy, through
+	 * Entity::update sequentially and through the ComponentScheduler in
+	 * parallel, against the ComponentRegistry data-oriented storage.
+	 *
+	 * Entities are standalone and updated one after the other, which
+	 * isn't the path of the engine: it updates components by type
+	 * through its tick lists.
+	 */
+	class BenchmarkComponents
+	{
+	public:
+		void run();
+
+	private:
+		void _run_entities( int entities_count );
+		void _run_parallel( int entities_count );
+		void _run_registry( int entities_count );
+	};
+}
@@ -0,0 +1,122 @@
+#include "benchmark-hash-maps.h"
+
+#include <suprengine/utils/flat-hash-map.h>
+
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace benchmark;
+using namespace suprengine;
+
+constexpr int KEYS_COUNTS[] { 16, 256, 4'096 };
+
+/*
+ * Names looking like assets or scopes names, long enough to not fit in
+ * the small string buffer.
+ */
+static std::vector<std::string> generate_keys( const int count, const char* prefix )
+{
+	std::vector<std::string> keys {};
+	keys.reserve( count );
+	for ( int i = 0; i < count; i++ )
+	{
+		keys.push_back( prefix + std::to_string( i * 7919 ) );
+	}
+	return keys;
+}
+
+/*
+ * Standard containers are searched with their key type, as searching with
+ * a C string would construct a temporary string at each lookup. FlatHashMap
+ * is searched with a C string, as done by its users.
+ */
+template <typename MapType>
+static decltype( auto ) get_lookup_key( const std::string& key )
+{
+	if constexpr ( std::is_same_v<MapType, FlatHashMap<std::string, int>> )
+	{
+		return key.c_str();
+	}
+	else
+	{
+		return key;
+	}
+}
+
+void BenchmarkHashMaps::run( MicroBenchmarkSuite& suite )
+{
+	for ( const int keys_count : KEYS_COUNTS )
+	{
+		_run_map<std::map<std::string, int>>( suite, "std::map", keys_count );
+		_run_map<std::unordered_map<std::string, int>>( suite, "std::unordered_map", keys_count );
+		_run_map<FlatHashMap<std::string, int>>( suite, "FlatHashMap", keys_count );
+	}
+}
+
+template <typename MapType>
+void BenchmarkHashMaps::_run_map( MicroBenchmarkSuite& suite, const char* map_name, const int keys_count )
+{
+	const std::vector<std::string> keys = generate_keys( keys_count, "assets/models/mesh-" );
+	const std::vector<std::string> missing_keys = generate_keys( keys_count, "assets/models/none-" );
+	const std::string suffix = " (" + std::to_string( keys_count ) + " keys)";
+
+	MapType map {};
+	for ( int i = 0; i < keys_count; i++ )
+	{
+		map[keys[i]] = i;
+	}
+
+	int sum = 0;
+	suite.run(
+		std::string( map_name ) + "::find (hit)" + suffix,
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				const auto itr = map.find( get_lookup_key<MapType>( keys[i % keys_count] ) );
+				sum += itr->second;
+			}
+		}
+	);
+	suite.run(
+		std::string( map_name ) + "::find (miss)" + suffix,
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				sum += map.find( get_lookup_key<MapType>( missing_keys[i % keys_count] ) ) == map.end();
+			}
+		}
+	);
+	suite.run(
+		std::string( map_name ) + "::insert" + suffix,
+		[&]( const int iterations )
+		{
+			MapType inserted_map {};
+			for ( int i = 0; i < iterations; i++ )
+			{
+				if ( i % keys_count == 0 )
+				{
+					inserted_map.clear();
+				}
+				inserted_map.emplace( keys[i % keys_count], i );
+			}
+			sum += static_cast<int>( inserted_map.size() );
+		}
+	);
+	suite.run(
+		std::string( map_name ) + "::iterate" + suffix,
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				for ( const auto& pair : map )
+				{
+					sum += pair.second;
+				}
+			}
+		}
+	);
+	do_not_optimize( sum );
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "micro-benchmark.h"
+
+namespace benchmark
+{
+	/*
+	 * Micro-benchmarks of the engine FlatHashMap against the standard
+	 * maps it replaces, with string keys searched from 'const char*' as
+	 * the engine registries are.
+	 */
+	class BenchmarkHashMaps
+	{
+	public:
+		void run( MicroBenchmarkSuite& suite );
+
+	private:
+		template <typename MapType>
+		void _run_map( MicroBenchmarkSuite& suite, const char* map_name, int keys_count );
+	};
+}
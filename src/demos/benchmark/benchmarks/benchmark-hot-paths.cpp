@@ -0,0 +1,303 @@
+#include "benchmark-hot-paths.h"
+
+#include <suprengine/components/colliders/sphere-collider.h>
+#include <suprengine/core/assets.h>
+#include <suprengine/core/engine.h>
+#include <suprengine/core/physics.h>
+
+#include <random>
+
+using namespace benchmark;
+using namespace suprengine;
+
+constexpr int LISTENERS_COUNTS[] { 1, 10, 100, 1'000 };
+constexpr int COLLIDERS_COUNTS[] { 100, 1'000, 10'000 };
+
+//	Half-extent of the cube in which colliders are spread
+constexpr float WORLD_EXTENT = 500.0f;
+
+template <int Index>
+class DummyComponent : public Component {};
+
+void BenchmarkHotPaths::run( MicroBenchmarkSuite& suite )
+{
+	_run_events( suite );
+	_run_physics( suite );
+	_run_math( suite );
+	_run_transform( suite );
+	_run_find_component( suite );
+	_run_entities_churn( suite );
+	_run_assets( suite );
+}
+
+void BenchmarkHotPaths::_run_events( MicroBenchmarkSuite& suite )
+{
+	for ( const int listeners_count : LISTENERS_COUNTS )
+	{
+		int calls_count = 0;
+		Event<int> event {};
+		for ( int i = 0; i < listeners_count; i++ )
+		{
+			event.listen( [&calls_count]( int value ) { calls_count += value; } );
+		}
+
+		suite.run(
+			"Event::invoke (" + std::to_string( listeners_count ) + " listeners)",
+			[&]( const int iterations )
+			{
+				for ( int i = 0; i < iterations; i++ )
+				{
+					event.invoke( 1 );
+				}
+			}
+		);
+		do_not_optimize( calls_count );
+	}
+}
+
+void BenchmarkHotPaths::_run_physics( MicroBenchmarkSuite& suite )
+{
+	Engine& engine = Engine::instance();
+	Physics* physics = engine.get_physics();
+
+	for ( const int colliders_count : COLLIDERS_COUNTS )
+	{
+		//	Spread colliders with a fixed seed for reproducible results
+		std::mt19937 random( 0 );
+		std::uniform_real_distribution<float> location_distribution( -WORLD_EXTENT, WORLD_EXTENT );
+		for ( int i = 0; i < colliders_count; i++ )
+		{
+			SharedPtr<Entity> entity = engine.create_entity<Entity>();
+			entity->transform->set_location(
+				Vec3 {
+					location_distribution( random ),
+					location_distribution( random ),
+					location_distribution( random ),
+				}
+			);
+			entity->create_component<SphereCollider>( 1.0f );
+		}
+
+		const std::string suffix = " (" + std::to_string( colliders_count ) + " colliders)";
+		suite.run(
+			"Physics::update" + suffix,
+			[&]( const int iterations )
+			{
+				for ( int i = 0; i < iterations; i++ )
+				{
+					physics->update();
+				}
+			}
+		);
+
+		//	Cast rays through the world, most of them missing
+		int hits_count = 0;
+		suite.run(
+			"Physics::raycast" + suffix,
+			[&]( const int iterations )
+			{
+				for ( int i = 0; i < iterations; i++ )
+				{
+					const float offset = static_cast<float>( i % 100 ) - 50.0f;
+					const Ray ray( Vec3 { -WORLD_EXTENT, offset, offset }, Vec3 { 1.0f, 0.0f, 0.0f }, WORLD_EXTENT * 2.0f );
+
+					RayHit hit {};
+					hits_count += physics->raycast( ray, &hit, RayParams {} ) ? 1 : 0;
+				}
+			}
+		);
+		do_not_optimize( hits_count );
+
+		engine.clear_entities();
+	}
+}
+
+void BenchmarkHotPaths::_run_math( MicroBenchmarkSuite& suite )
+{
+	const Mtx4 matrix = Mtx4::create_from_transform(
+		Vec3 { 1.0f, 1.0f, 1.0f },
+		Quaternion::identity,
+		Vec3 { 1.0f, 2.0f, 3.0f }
+	);
+
+	//	Chain operations so none can be skipped
+	Mtx4 result = Mtx4::identity;
+	suite.run(
+		"Mtx4::operator*",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				result = result * matrix;
+			}
+		}
+	);
+	do_not_optimize( result[0][0] );
+
+	result = matrix;
+	suite.run(
+		"Mtx4::inverse",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				result = result.inverse();
+			}
+		}
+	);
+	do_not_optimize( result[0][0] );
+}
+
+void BenchmarkHotPaths::_run_transform( MicroBenchmarkSuite& suite )
+{
+	Engine& engine = Engine::instance();
+	SharedPtr<Entity> entity = engine.create_entity<Entity>();
+	Transform* transform = entity->transform.get();
+
+	float sum = 0.0f;
+	suite.run(
+		"Transform::get_matrix (dirty)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				transform->set_location( Vec3 { static_cast<float>( i ), 0.0f, 0.0f } );
+				sum += transform->get_matrix()[0][3];
+			}
+		}
+	);
+	suite.run(
+		"Transform::get_matrix (cached)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				sum += transform->get_matrix()[0][3];
+			}
+		}
+	);
+	do_not_optimize( sum );
+
+	engine.clear_entities();
+}
+
+void BenchmarkHotPaths::_run_find_component( MicroBenchmarkSuite& suite )
+{
+	Engine& engine = Engine::instance();
+	SharedPtr<Entity> entity = engine.create_entity<Entity>();
+	entity->create_component<DummyComponent<0>>();
+	entity->create_component<DummyComponent<1>>();
+	entity->create_component<DummyComponent<2>>();
+	entity->create_component<DummyComponent<3>>();
+	entity->create_component<DummyComponent<4>>();
+	entity->create_component<DummyComponent<5>>();
+	entity->create_component<DummyComponent<6>>();
+	entity->create_component<DummyComponent<7>>();
+
+	std::size_t found_count = 0;
+	suite.run(
+		"Entity::find_component (exact type)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += entity->find_component<DummyComponent<7>>() != nullptr;
+			}
+		}
+	);
+	suite.run(
+		"Entity::find_component (base type)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += entity->find_component<Collider>() != nullptr;
+			}
+		}
+	);
+	do_not_optimize( found_count );
+
+	engine.clear_entities();
+}
+
+void BenchmarkHotPaths::_run_entities_churn( MicroBenchmarkSuite& suite )
+{
+	Engine& engine = Engine::instance();
+
+	suite.run(
+		"Engine::create_entity/remove_entity",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				SharedPtr<Entity> entity = engine.create_entity<Entity>();
+				engine.remove_entity( entity );
+			}
+		}
+	);
+
+	SharedPtr<Entity> entity = engine.create_entity<Entity>();
+	suite.run(
+		"Engine::add_entity/remove_entity",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				engine.remove_entity( entity );
+				engine.add_entity( entity );
+			}
+		}
+	);
+
+	engine.clear_entities();
+}
+
+void BenchmarkHotPaths::_run_assets( MicroBenchmarkSuite& suite )
+{
+	std::size_t found_count = 0;
+	suite.run(
+		"Assets::get_texture",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += Assets::get_texture( TEXTURE_WHITE ) != nullptr;
+			}
+		}
+	);
+	suite.run(
+		"Assets::get_model",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += Assets::get_model( MESH_CUBE ) != nullptr;
+			}
+		}
+	);
+
+	//	Names hashed beforehand, as literals are at compile time
+	const StringId texture_id = TEXTURE_WHITE;
+	const StringId model_id = MESH_CUBE;
+	suite.run(
+		"Assets::get_texture (StringId)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += Assets::get_texture( texture_id ) != nullptr;
+			}
+		}
+	);
+	suite.run(
+		"Assets::get_model (StringId)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				found_count += Assets::get_model( model_id ) != nullptr;
+			}
+		}
+	);
+	do_not_optimize( found_count );
+}
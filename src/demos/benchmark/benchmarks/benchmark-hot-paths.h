@@ -0,0 +1,25 @@
+#pragma once
+
+#include "micro-benchmark.h"
+
+namespace benchmark
+{
+	/*
+	 * Micro-benchmarks of the engine hot paths.
+	 * Requires the engine to be initialized, headless or not.
+	 */
+	class BenchmarkHotPaths
+	{
+	public:
+		void run( MicroBenchmarkSuite& suite );
+
+	private:
+		void _run_events( MicroBenchmarkSuite& suite );
+		void _run_physics( MicroBenchmarkSuite& suite );
+		void _run_math( MicroBenchmarkSuite& suite );
+		void _run_transform( MicroBenchmarkSuite& suite );
+		void _run_find_component( MicroBenchmarkSuite& suite );
+		void _run_entities_churn( MicroBenchmarkSuite& suite );
+		void _run_assets( MicroBenchmarkSuite& suite );
+	};
+}
@@ -0,0 +1,93 @@
+#include "benchmark-profiler.h"
+
+#include <suprengine/core/engine.h>
+#include <suprengine/tools/profiler.h>
+
+using namespace benchmark;
+using namespace suprengine;
+
+//	Amount of scopes recorded between two collections, keeping the 
+//	thread buffer from being full
+constexpr int SCOPES_PER_UPDATE = 1'024;
+
+void BenchmarkProfiler::run( MicroBenchmarkSuite& suite )
+{
+	Profiler* profiler = Engine::instance().get_profiler();
+	const bool was_profiling = profiler->is_profiling();
+
+	int value = 0;
+	suite.run(
+		"Empty loop",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				do_not_optimize( ++value );
+			}
+		}
+	);
+
+	profiler->stop();
+	suite.run(
+		"PROFILE_SCOPE (not profiling)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				PROFILE_SCOPE( "Benchmark" );
+				do_not_optimize( ++value );
+			}
+		}
+	);
+
+	//	Collections are part of the measured cost
+	profiler->start();
+	suite.run(
+		"PROFILE_SCOPE (profiling)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				{
+					PROFILE_SCOPE( "Benchmark" );
+					do_not_optimize( ++value );
+				}
+
+				if ( ( i + 1 ) % SCOPES_PER_UPDATE == 0 )
+				{
+					profiler->update();
+				}
+			}
+			profiler->update();
+		}
+	);
+	suite.run(
+		"PROFILE_SCOPE (profiling, 4 nested)",
+		[&]( const int iterations )
+		{
+			for ( int i = 0; i < iterations; i++ )
+			{
+				{
+					PROFILE_SCOPE( "Benchmark 1" );
+					PROFILE_SCOPE( "Benchmark 2" );
+					PROFILE_SCOPE( "Benchmark 3" );
+					PROFILE_SCOPE( "Benchmark 4" );
+					do_not_optimize( ++value );
+				}
+
+				if ( ( i + 1 ) % ( SCOPES_PER_UPDATE / 4 ) == 0 )
+				{
+					profiler->update();
+				}
+			}
+			profiler->update();
+		}
+	);
+
+	//	Restore the profiler for the next benchmarks
+	profiler->clear();
+	if ( !was_profiling )
+	{
+		profiler->stop();
+	}
+}
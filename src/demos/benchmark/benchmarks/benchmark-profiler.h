@@ -0,0 +1,17 @@
+#pragma once
+
+#include "micro-benchmark.h"
+
+namespace benchmark
+{
+	/*
+	 * Micro-benchmarks of the profiler scopes overhead, whenever it is
+	 * profiling or not. Uses the engine profiler, so it requires the
+	 * engine to be initialized, headless or not.
+	 */
+	class BenchmarkProfiler
+	{
+	public:
+		void run( MicroBenchmarkSuite& suite );
+	};
+}
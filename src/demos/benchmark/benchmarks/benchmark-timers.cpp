@@ -0,0 +1,122 @@
+#include "benchmark-timers.h"
+
+#include <suprengine/core/timer-wheel.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace benchmark;
+using namespace suprengine;
+
+namespace chrono = std::chrono;
+
+//	Simulate 10 seconds at 60 FPS
+constexpr int FRAMES_COUNT = 600;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+constexpr int TIMERS_COUNTS[] { 10'000, 100'000 };
+constexpr float MIN_TIME = 0.1f, MAX_TIME = 10.0f;
+//	One timer out of this amount loops infinitely
+constexpr int LOOPING_RATIO = 10;
+
+static std::vector<Timer> generate_timers( const int timers_count, int* calls_count )
+{
+	std::mt19937 random( 0 );
+	std::uniform_real_distribution<float> time_distribution( MIN_TIME, MAX_TIME );
+
+	std::vector<Timer> timers {};
+	timers.reserve( timers_count );
+	for ( int i = 0; i < timers_count; i++ )
+	{
+		const uint32 repetitions = i % LOOPING_RATIO == 0 ? 0 : 1;
+		timers.emplace_back( [calls_count]() { ( *calls_count )++; }, time_distribution( random ), repetitions );
+	}
+
+	return timers;
+}
+
+static void print_result( const char* name, const int timers_count, const int calls_count, const chrono::steady_clock::duration& duration )
+{
+	const double total_ms = chrono::duration<double, std::milli>( duration ).count();
+	const double frame_ms = total_ms / FRAMES_COUNT;
+
+	printf(
+		"Benchmark: %-10s %8d timers: %9.3fms/frame (%d calls)\n",
+		name, timers_count, frame_ms, calls_count
+	);
+}
+
+void BenchmarkTimers::run()
+{
+	for ( const int timers_count : TIMERS_COUNTS )
+	{
+		_run_vector( timers_count );
+		_run_wheel( timers_count );
+	}
+}
+
+void BenchmarkTimers::_run_vector( const int timers_count )
+{
+	struct VectorTimer
+	{
+		Timer timer {};
+		float current_time = 0.0f;
+	};
+
+	int calls_count = 0;
+	std::vector<VectorTimer> timers {};
+	for ( const Timer& timer : generate_timers( timers_count, &calls_count ) )
+	{
+		timers.push_back( VectorTimer { timer } );
+	}
+
+	//	Update them as the engine used to, scanning all timers
+	const auto start_time = chrono::steady_clock::now();
+	for ( int frame = 0; frame < FRAMES_COUNT; frame++ )
+	{
+		auto itr = timers.begin();
+		while ( itr != timers.end() )
+		{
+			VectorTimer& timer = *itr;
+			if ( ( timer.current_time += DELTA_TIME ) < timer.timer.max_time )
+			{
+				itr++;
+				continue;
+			}
+
+			timer.timer.callback();
+
+			if ( timer.timer.repetitions > 0 && --timer.timer.repetitions == 0 )
+			{
+				itr = timers.erase( itr );
+				continue;
+			}
+
+			timer.current_time -= timer.timer.max_time;
+			itr++;
+		}
+	}
+	const auto end_time = chrono::steady_clock::now();
+
+	print_result( "Vector", timers_count, calls_count, end_time - start_time );
+}
+
+void BenchmarkTimers::_run_wheel( const int timers_count )
+{
+	int calls_count = 0;
+	TimerWheel wheel {};
+	for ( const Timer& timer : generate_timers( timers_count, &calls_count ) )
+	{
+		wheel.add( timer );
+	}
+
+	const auto start_time = chrono::steady_clock::now();
+	for ( int frame = 0; frame < FRAMES_COUNT; frame++ )
+	{
+		wheel.update( DELTA_TIME );
+	}
+	const auto end_time = chrono::steady_clock::now();
+
+	print_result( "Wheel", timers_count, calls_count, end_time - start_time );
+}
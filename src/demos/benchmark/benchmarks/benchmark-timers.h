@@ -0,0 +1,18 @@
+#pragma once
+
+namespace benchmark
+{
+	/*
+	 * Compare the update cost of the engine's TimerWheel against a vector
+	 * of timers scanned at each update, with many long-lived timers.
+	 */
+	class BenchmarkTimers
+	{
+	public:
+		void run();
+
+	private:
+		void _run_vector( int timers_count );
+		void _run_wheel( int timers_count );
+	};
+}
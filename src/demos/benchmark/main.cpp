@@ -0,0 +1,119 @@
+#include <suprengine/core/engine.h>
+#include <suprengine/rendering/null/null-render-batch.h>
+
+#include "benchmarks/benchmark-components.h"
+#include "benchmarks/benchmark-hash-maps.h"
+#include "benchmarks/benchmark-hot-paths.h"
+#include "benchmarks/benchmark-profiler.h"
+#include "benchmarks/benchmark-timers.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace suprengine;
+
+/*
+ * Minimal game providing the engine assets to the hot paths benchmarks.
+ */
+class BenchmarkGame : public Game<NullRenderBatch>
+{
+public:
+	void load_assets() override {}
+	void init() override {}
+	void release() override {}
+
+	GameInfos get_infos() const override
+	{
+		GameInfos infos {};
+		infos.window.title = "Benchmark";
+		infos.window.width = 1280;
+		infos.window.height = 720;
+		return infos;
+	}
+};
+
+int main( int arg_count, char** args )
+{
+	//	Parse arguments, running all suites unless one is specified
+	const char* suite_name = nullptr;
+	const char* baseline_path = nullptr;
+	const char* save_baseline_path = nullptr;
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		if ( std::strcmp( args[i], "--baseline" ) == 0 && i + 1 < arg_count )
+		{
+			baseline_path = args[++i];
+		}
+		else if ( std::strcmp( args[i], "--save-baseline" ) == 0 && i + 1 < arg_count )
+		{
+			save_baseline_path = args[++i];
+		}
+		else
+		{
+			suite_name = args[i];
+		}
+	}
+
+	const auto should_run = [suite_name]( const char* name )
+	{
+		return suite_name == nullptr || std::strcmp( suite_name, name ) == 0;
+	};
+
+	if ( should_run( "components" ) )
+	{
+		benchmark::BenchmarkComponents().run();
+	}
+	if ( should_run( "timers" ) )
+	{
+		benchmark::BenchmarkTimers().run();
+	}
+
+	//	Micro-benchmarks, the hot paths and profiler ones requiring the engine
+	int regressions_count = 0;
+	const bool should_run_hot_paths = should_run( "hot-paths" );
+	const bool should_run_profiler = should_run( "profiler" );
+	const bool should_run_hash_maps = should_run( "hash-maps" );
+	if ( should_run_hot_paths || should_run_profiler || should_run_hash_maps )
+	{
+		if ( should_run_hot_paths || should_run_profiler )
+		{
+			EngineInfos infos {};
+			infos.is_headless = true;
+
+			Engine& engine = Engine::instance();
+			if ( !engine.init<BenchmarkGame>( infos ) ) return EXIT_FAILURE;
+		}
+
+		benchmark::MicroBenchmarkSuite suite {};
+		if ( baseline_path != nullptr && !suite.load_baseline( baseline_path ) )
+		{
+			Logger::error( "Failed to load baseline from '%s'!", baseline_path );
+		}
+
+		if ( should_run_hash_maps )
+		{
+			benchmark::BenchmarkHashMaps().run( suite );
+		}
+		if ( should_run_hot_paths )
+		{
+			benchmark::BenchmarkHotPaths().run( suite );
+		}
+		if ( should_run_profiler )
+		{
+			benchmark::BenchmarkProfiler().run( suite );
+		}
+
+		if ( save_baseline_path != nullptr && !suite.save_baseline( save_baseline_path ) )
+		{
+			Logger::error( "Failed to save baseline to '%s'!", save_baseline_path );
+		}
+		regressions_count = suite.get_regressions_count();
+	}
+
+	if ( regressions_count > 0 )
+	{
+		Logger::error( "Benchmark: %d regression(s) found!", regressions_count );
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+#include "micro-benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+using namespace benchmark;
+
+namespace chrono = std::chrono;
+
+//	Avoid calibrating indefinitely on empty benchmarks
+constexpr int MAX_ITERATIONS = 1 << 30;
+
+static double measure( const MicroBenchmarkSuite::Function& function, const int iterations )
+{
+	const auto start_time = chrono::steady_clock::now();
+	function( iterations );
+	const auto end_time = chrono::steady_clock::now();
+
+	return chrono::duration<double>( end_time - start_time ).count();
+}
+
+MicroBenchmarkSuite::MicroBenchmarkSuite( const int repetitions, const double min_repetition_time )
+	: _repetitions( repetitions ), _min_repetition_time( min_repetition_time )
+{}
+
+const MicroBenchmarkResult& MicroBenchmarkSuite::run( rconst_str name, const Function& function )
+{
+	//	Calibrate the iterations, also warming up caches
+	int iterations = 1;
+	while ( iterations < MAX_ITERATIONS && measure( function, iterations ) < _min_repetition_time )
+	{
+		iterations *= 2;
+	}
+
+	//	Measure repetitions
+	std::vector<double> times( _repetitions );
+	for ( double& time : times )
+	{
+		time = measure( function, iterations ) * 1e9 / iterations;
+	}
+	std::sort( times.begin(), times.end() );
+
+	MicroBenchmarkResult result {};
+	result.name = name;
+	result.repetitions = _repetitions;
+	result.iterations = iterations;
+	result.min = times.front();
+	result.median = _repetitions % 2 == 0
+		? ( times[_repetitions / 2 - 1] + times[_repetitions / 2] ) * 0.5
+		: times[_repetitions / 2];
+
+	for ( const double time : times )
+	{
+		result.mean += time;
+	}
+	result.mean /= _repetitions;
+
+	for ( const double time : times )
+	{
+		result.stddev += ( time - result.mean ) * ( time - result.mean );
+	}
+	result.stddev = std::sqrt( result.stddev / _repetitions );
+
+	printf(
+		"Benchmark: %-40s %12.2fns (stddev: %5.1f%%; %d x %d)",
+		*name, result.median,
+		result.mean > 0.0 ? result.stddev / result.mean * 100.0 : 0.0,
+		result.repetitions, result.iterations
+	);
+
+	//	Compare with baseline
+	if ( const double* baseline = _find_baseline( name ) )
+	{
+		const double difference = ( result.median - *baseline ) / *baseline;
+		const bool is_regression = difference > regression_tolerance;
+		if ( is_regression )
+		{
+			_regressions_count++;
+		}
+
+		printf( " %+7.1f%%%s", difference * 100.0, is_regression ? " REGRESSION" : "" );
+	}
+	printf( "\n" );
+
+	_results.push_back( result );
+	return _results.back();
+}
+
+bool MicroBenchmarkSuite::load_baseline( rconst_str path )
+{
+	std::ifstream file( path );
+	if ( !file.is_open() ) return false;
+
+	//	Each line is a benchmark name and its median, separated by a tab
+	_baseline.clear();
+	std::string line {};
+	while ( std::getline( file, line ) )
+	{
+		const std::size_t separator = line.rfind( '\t' );
+		if ( separator == std::string::npos ) continue;
+
+		_baseline.emplace_back( line.substr( 0, separator ), std::stod( line.substr( separator + 1 ) ) );
+	}
+
+	return true;
+}
+
+bool MicroBenchmarkSuite::save_baseline( rconst_str path ) const
+{
+	std::ofstream file( path );
+	if ( !file.is_open() ) return false;
+
+	for ( const MicroBenchmarkResult& result : _results )
+	{
+		file << result.name << '\t' << result.median << '\n';
+	}
+
+	return true;
+}
+
+int MicroBenchmarkSuite::get_regressions_count() const
+{
+	return _regressions_count;
+}
+
+const double* MicroBenchmarkSuite::_find_baseline( rconst_str name ) const
+{
+	for ( const auto& [baseline_name, median] : _baseline )
+	{
+		if ( baseline_name != name ) continue;
+
+		return &median;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+	struct MicroBenchmarkResult
+	{
+		std::string name {};
+
+		int repetitions = 0;
+		/*
+		 * Amount of iterations run by each repetition.
+		 */
+		int iterations = 0;
+
+		/*
+		 * Statistics of the time per iteration, in nanoseconds, 
+		 * over all repetitions.
+		 */
+		double median = 0.0;
+		double mean = 0.0;
+		double stddev = 0.0;
+		double min = 0.0;
+	};
+
+	/*
+	 * Runs micro-benchmarks and computes stable statistics over their
+	 * repetitions, optionally comparing them against a baseline file.
+	 *
+	 * Each benchmark is a function running the measured operation a 
+	 * given amount of iterations. This amount is calibrated so a 
+	 * repetition lasts at least 'min_repetition_time'.
+	 */
+	class MicroBenchmarkSuite
+	{
+	public:
+		using Function = std::function<void( int iterations )>;
+
+	public:
+		MicroBenchmarkSuite( int repetitions = 15, double min_repetition_time = 0.01 );
+
+		const MicroBenchmarkResult& run( rconst_str name, const Function& function );
+
+		/*
+		 * Load medians of a previous run to compare the next results against.
+		 * Returns whenever the file could be read.
+		 */
+		bool load_baseline( rconst_str path );
+		/*
+		 * Save medians of the results as a baseline file.
+		 * Returns whenever the file could be written.
+		 */
+		bool save_baseline( rconst_str path ) const;
+
+		/*
+		 * Returns the amount of results slower than their baseline
+		 * by more than 'regression_tolerance'.
+		 */
+		int get_regressions_count() const;
+
+		const std::vector<MicroBenchmarkResult>& get_results() const { return _results; }
+
+	public:
+		/*
+		 * Relative difference of median above which a result is 
+		 * considered regressed from its baseline.
+		 */
+		double regression_tolerance = 0.1;
+
+	private:
+		const double* _find_baseline( rconst_str name ) const;
+
+	private:
+		int _repetitions = 0;
+		double _min_repetition_time = 0.0;
+
+		std::vector<MicroBenchmarkResult> _results {};
+		std::vector<std::pair<std::string, double>> _baseline {};
+		int _regressions_count = 0;
+	};
+
+	/*
+	 * Prevent the compiler from optimizing away the computation of a value.
+	 */
+	template <typename T>
+	void do_not_optimize( const T& value )
+	{
+#if defined( __GNUC__ ) || defined( __clang__ )
+		//  Empty assembly pretending to read the value from memory
+		asm volatile( "" : : "m"( value ) : "memory" );
+#else
+		//  Read the value back through a volatile access, which can't be skipped
+		const volatile char* bytes = reinterpret_cast<const volatile char*>( &value );
+		static_cast<void>( *bytes );
+#endif
+	}
+}
@@ -27,6 +27,11 @@ void GameInstance::init()
 	render_batch->set_background_color( Color::from_0x( 0x000000 ) );
 
     //  load scene
+	if ( _stress_settings.has_value() )
+	{
+		engine.create_scene<StressScene>( *_stress_settings );
+		return;
+	}
 	engine.create_scene<GameScene>();
 }
 
@@ -5,6 +5,10 @@
 
 #include <suprengine/input/input-manager.h>
 
+#include <suprengine/tools/stress-scene.h>
+
+#include <optional>
+
 namespace test
 {
 	using namespace suprengine;
@@ -12,6 +16,13 @@ namespace test
 	class GameInstance : public Game<OpenGLRenderBatch>
 	{
 	public:
+		GameInstance() = default;
+		/*
+		 * Run a stress scene with the given settings instead of the game scene.
+		 */
+		GameInstance( const StressSceneSettings& stress_settings )
+			: _stress_settings( stress_settings ) {}
+
 		void load_assets() override;
 
 		void init() override;
@@ -21,5 +32,8 @@ namespace test
 
 	private:
 		void setup_input_actions( InputManager* inputs );
+
+	private:
+		std::optional<StressSceneSettings> _stress_settings {};
 	};
 }
\ No newline at end of file
@@ -2,10 +2,74 @@
 
 #include "game-instance.h"
 
+#include <cstdlib>
+#include <cstring>
+
 using namespace suprengine;
 
 int main( int arg_count, char** args )
 {
+	EngineInfos infos {};
+	StressSceneSettings stress_settings {};
+	bool should_stress = false;
+	for ( int i = 1; i < arg_count; i++ )
+	{
+		//  Allow running without window, e.g. on CI
+		if ( std::strcmp( args[i], "--headless" ) == 0 )
+		{
+			infos.is_headless = true;
+		}
+		//  Run a fixed amount of frames and write a benchmark report
+		else if ( std::strcmp( args[i], "--benchmark" ) == 0 && i + 1 < arg_count )
+		{
+			infos.benchmark_frames_count = std::atoi( args[++i] );
+		}
+		else if ( std::strcmp( args[i], "--benchmark-report" ) == 0 && i + 1 < arg_count )
+		{
+			infos.benchmark_report_path = args[++i];
+		}
+		//  Capture the first frames into a Chrome trace
+		else if ( std::strcmp( args[i], "--trace" ) == 0 && i + 1 < arg_count )
+		{
+			infos.trace_frames_count = std::atoi( args[++i] );
+		}
+		else if ( std::strcmp( args[i], "--trace-path" ) == 0 && i + 1 < arg_count )
+		{
+			infos.trace_path = args[++i];
+		}
+		//  Spawn a given amount of entities in a stress scene
+		else if ( std::strcmp( args[i], "--stress" ) == 0 && i + 1 < arg_count )
+		{
+			stress_settings.entities_count = std::atoi( args[++i] );
+			should_stress = true;
+		}
+		else if ( std::strcmp( args[i], "--stress-churn" ) == 0 && i + 1 < arg_count )
+		{
+			const float churn = static_cast<float>( std::atof( args[++i] ) );
+			stress_settings.spawns_per_second = churn;
+			stress_settings.kills_per_second = churn;
+		}
+		else if ( std::strcmp( args[i], "--stress-seed" ) == 0 && i + 1 < arg_count )
+		{
+			stress_settings.seed = static_cast<unsigned int>( std::atoi( args[++i] ) );
+		}
+		//  Measure the frame times of doubling amounts of entities, up to the given one
+		else if ( std::strcmp( args[i], "--stress-scaling" ) == 0 && i + 1 < arg_count )
+		{
+			const int max_entities_count = std::atoi( args[++i] );
+			for ( int count = 1000; count <= max_entities_count; count *= 2 )
+			{
+				stress_settings.scaling_steps.push_back( count );
+			}
+			stress_settings.should_quit_after_scaling = true;
+			should_stress = true;
+		}
+	}
+
 	auto& engine = Engine::instance();
-	return engine.run<test::GameInstance>();
-}
\ No newline at end of file
+	if ( !should_stress ) return engine.run<test::GameInstance>( infos );
+
+	if ( !engine.init( new test::GameInstance( stress_settings ), infos ) ) return EXIT_FAILURE;
+	engine.loop();
+	return EXIT_SUCCESS;
+}
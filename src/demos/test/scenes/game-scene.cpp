@@ -10,7 +10,11 @@
 
 #include <suprengine/utils/random.h>
 
+#include "tests/unit-test-entity-command-buffer.h"
 #include "tests/unit-test-event.h"
+#include "tests/unit-test-flat-hash-map.h"
+#include "tests/unit-test-job-system.h"
+#include "tests/unit-test-timer-wheel.h"
 
 #include <GL/glew.h>
 
@@ -61,6 +65,10 @@ void on_imgui_update()
 void GameScene::init()
 {
 	UnitTestEvent().run();
+	UnitTestFlatHashMap().run();
+	UnitTestJobSystem().run();
+	UnitTestEntityCommandBuffer().run();
+	UnitTestTimerWheel().run();
 
 	auto& engine = Engine::instance();
 	engine.on_imgui_update.listen( &on_imgui_update );
@@ -0,0 +1,64 @@
+#include "unit-test-entity-command-buffer.h"
+
+#include <suprengine/core/engine.h>
+#include <suprengine/core/entity-command-buffer.h>
+#include <suprengine/utils/assert.h>
+
+using namespace test;
+using namespace suprengine;
+
+class CommandTestComponent : public Component {};
+
+class CommandTestEntity : public Entity
+{
+public:
+	void setup() override
+	{
+		has_component_on_setup = find_component<CommandTestComponent>() != nullptr;
+	}
+
+public:
+	bool has_component_on_setup = false;
+};
+
+void UnitTestEntityCommandBuffer::run()
+{
+	Engine& engine = Engine::instance();
+	EntityCommandBuffer buffer {};
+
+	SharedPtr<Entity> entity = engine.create_entity<Entity>();
+	SharedPtr<CommandTestComponent> component = entity->create_component<CommandTestComponent>();
+
+	//	Check that removing then adding back a component keeps it.
+	buffer.remove_component( entity, component );
+	buffer.add_component( entity, component );
+	engine.flush_command_buffer( &buffer );
+	ASSERT( entity->find_component<CommandTestComponent>() == component.get() );
+	ASSERT( buffer.is_empty() );
+
+	//	Check that adding then removing a component removes it.
+	SharedPtr<CommandTestComponent> other_component = buffer.create_component<CommandTestComponent>( entity );
+	buffer.remove_component( entity, other_component );
+	buffer.remove_component( entity, component );
+	engine.flush_command_buffer( &buffer );
+	ASSERT( entity->find_component<CommandTestComponent>() == nullptr );
+
+	//	Check that components of created entities are added before their setup.
+	SharedPtr<CommandTestEntity> created_entity = buffer.create_entity<CommandTestEntity>();
+	buffer.create_component<CommandTestComponent>( created_entity );
+	ASSERT( !engine.is_entity_valid( created_entity->get_handle() ) );
+	engine.flush_command_buffer( &buffer );
+	ASSERT( created_entity->has_component_on_setup );
+	ASSERT( engine.is_entity_valid( created_entity->get_handle() ) );
+
+	//	Check that a created then killed entity is killed once added.
+	SharedPtr<Entity> killed_entity = buffer.create_entity<Entity>();
+	buffer.kill( killed_entity );
+	engine.flush_command_buffer( &buffer );
+	ASSERT( killed_entity->state == EntityState::Invalid );
+
+	entity->kill();
+	created_entity->kill();
+
+	printf( "UnitTest: EntityCommandBuffer All Passed!\n" );
+}
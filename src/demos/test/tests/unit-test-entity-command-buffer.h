@@ -0,0 +1,9 @@
+
+namespace test
+{
+	class UnitTestEntityCommandBuffer
+	{
+	public:
+		void run();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "unit-test-flat-hash-map.h"
+
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/assert.h>
+
+#include <string>
+#include <string_view>
+
+using namespace test;
+using namespace suprengine;
+
+/*
+ * Hasher sending all keys to the same group, so it can be filled.
+ */
+struct CollidingHash
+{
+	std::size_t operator()( const int ) const
+	{
+		return 0;
+	}
+};
+
+void UnitTestFlatHashMap::run()
+{
+	//	Check that elements are found back across rehashes.
+	constexpr int COUNT = 1000;
+	FlatHashMap<int, int> map {};
+	for ( int i = 0; i < COUNT; i++ )
+	{
+		ASSERT( map.try_emplace( i, i * 2 ).second );
+	}
+	ASSERT( map.size() == COUNT );
+	ASSERT( map.capacity() >= COUNT );
+	ASSERT( map.try_emplace( 0, -1 ).second == false );
+	for ( int i = 0; i < COUNT; i++ )
+	{
+		const auto itr = map.find( i );
+		ASSERT( itr != map.end() && itr->second == i * 2 );
+	}
+	ASSERT( map.find( COUNT ) == map.end() );
+
+	//	Check that erasing keeps other elements reachable.
+	for ( int i = 0; i < COUNT; i += 2 )
+	{
+		ASSERT( map.erase( i ) == 1 );
+	}
+	ASSERT( map.erase( 0 ) == 0 );
+	ASSERT( map.size() == COUNT / 2 );
+	for ( int i = 0; i < COUNT; i++ )
+	{
+		ASSERT( map.contains( i ) == ( i % 2 == 1 ) );
+	}
+
+	//	Check that iteration after erasing only visits remaining elements.
+	int iterated_count = 0;
+	for ( const auto& [key, value] : map )
+	{
+		ASSERT( key % 2 == 1 && value == key * 2 );
+		iterated_count++;
+	}
+	ASSERT( iterated_count == COUNT / 2 );
+
+	//	Check that erasing while iterating visits each element once.
+	for ( auto itr = map.begin(); itr != map.end(); )
+	{
+		if ( itr->first % 4 == 1 )
+		{
+			itr = map.erase( itr );
+			continue;
+		}
+		itr++;
+	}
+	ASSERT( map.size() == COUNT / 4 );
+	for ( const auto& [key, value] : map )
+	{
+		ASSERT( key % 4 == 3 );
+	}
+
+	//	Check that erased keys can be inserted again after a rehash.
+	for ( int i = 0; i < COUNT * 2; i++ )
+	{
+		map[i] = i;
+	}
+	ASSERT( map.size() == COUNT * 2 );
+	for ( int i = 0; i < COUNT * 2; i++ )
+	{
+		ASSERT( map.find( i )->second == i );
+	}
+
+	//	Fill the first group, with one more element probed into the next group.
+	const std::size_t GROUP_SIZE = FlatHashMap<int, int, CollidingHash>::GROUP_SIZE;
+	const int colliding_count = static_cast<int>( GROUP_SIZE ) + 1;
+	FlatHashMap<int, int, CollidingHash> colliding_map {};
+	colliding_map.reserve( colliding_count );
+	const std::size_t capacity = colliding_map.capacity();
+	for ( int i = 0; i < colliding_count; i++ )
+	{
+		colliding_map[i] = i;
+	}
+
+	//	Check that erasing from a full group doesn't stop the probing
+	//	before the element of the next group.
+	ASSERT( colliding_map.erase( 3 ) == 1 );
+	ASSERT( colliding_map.contains( 3 ) == false );
+	ASSERT( colliding_map.find( colliding_count - 1 )->second == colliding_count - 1 );
+
+	//	Check that re-inserting uses the freed slot without duplicating elements.
+	ASSERT( colliding_map.try_emplace( 3, 30 ).second );
+	ASSERT( colliding_map.try_emplace( colliding_count - 1, 0 ).second == false );
+	ASSERT( colliding_map.size() == static_cast<std::size_t>( colliding_count ) );
+	ASSERT( colliding_map.capacity() == capacity );
+	ASSERT( colliding_map.find( 3 )->second == 30 );
+	for ( int i = 0; i < colliding_count; i++ )
+	{
+		ASSERT( colliding_map.contains( i ) );
+	}
+
+	//	Check that the element of the next group can be erased and
+	//	inserted again.
+	ASSERT( colliding_map.erase( colliding_count - 1 ) == 1 );
+	ASSERT( colliding_map.contains( colliding_count - 1 ) == false );
+	colliding_map[colliding_count - 1] = 0;
+	ASSERT( colliding_map.size() == static_cast<std::size_t>( colliding_count ) );
+
+	//	Check that string keys can be searched without constructing strings.
+	FlatHashMap<std::string, int> strings_map {};
+	strings_map.emplace( "apple", 1 );
+	strings_map.emplace( std::string( "banana" ), 2 );
+	ASSERT( strings_map.find( "apple" )->second == 1 );
+	ASSERT( strings_map.find( std::string_view( "banana" ) )->second == 2 );
+	ASSERT( strings_map.contains( std::string( "banana" ) ) );
+	ASSERT( strings_map.contains( "cherry" ) == false );
+
+	const char* banana = "banana split";
+	ASSERT( strings_map.contains( std::string_view( banana, 6 ) ) );
+	ASSERT( strings_map.erase( std::string_view( banana, 6 ) ) == 1 );
+	ASSERT( strings_map.contains( "banana" ) == false );
+	ASSERT( strings_map.size() == 1 );
+
+	printf( "UnitTest: FlatHashMap All Passed!\n" );
+}
@@ -0,0 +1,9 @@
+
+namespace test
+{
+	class UnitTestFlatHashMap
+	{
+	public:
+		void run();
+	};
+}
\ No newline at end of file
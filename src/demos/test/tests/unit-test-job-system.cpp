@@ -0,0 +1,90 @@
+#include "unit-test-job-system.h"
+
+#include <suprengine/core/engine.h>
+#include <suprengine/core/job-system.h>
+#include <suprengine/utils/assert.h>
+
+using namespace test;
+using namespace suprengine;
+
+void UnitTestJobSystem::run()
+{
+	//	Check that a nested system restores the worker registration of
+	//	the engine thread once destroyed.
+	JobSystem& jobs = *Engine::instance().get_jobs();
+	{
+		JobSystem nested_jobs( 1 );
+		ASSERT( nested_jobs.get_current_worker_index() == 0 );
+		ASSERT( jobs.get_current_worker_index() == INDEX_NONE );
+	}
+	ASSERT( jobs.get_current_worker_index() == 0 );
+
+	printf( "UnitTest: JobSystem running with %d workers\n", jobs.get_workers_count() );
+
+	//	Check that parallel_for covers the whole range exactly once.
+	constexpr int COUNT = 100000;
+	std::vector<int> values( COUNT, 0 );
+	jobs.parallel_for( COUNT,
+		[&]( int begin, int end )
+		{
+			for ( int i = begin; i < end; i++ )
+			{
+				values[i]++;
+			}
+		}
+	);
+	for ( int i = 0; i < COUNT; i++ )
+	{
+		ASSERT( values[i] == 1 );
+	}
+
+	//	Check that a group only starts once its dependencies are completed.
+	std::atomic<int> first_count { 0 };
+	std::atomic<bool> is_order_respected { true };
+	JobGroup first_group = jobs.create_group();
+	JobGroup second_group = jobs.create_group( { first_group } );
+	for ( int i = 0; i < 64; i++ )
+	{
+		jobs.add_job( second_group,
+			[&]()
+			{
+				if ( first_count.load() != 64 )
+				{
+					is_order_respected = false;
+				}
+			}
+		);
+		jobs.add_job( first_group, [&]() { first_count++; } );
+	}
+	jobs.submit( second_group );
+	ASSERT( !second_group.is_completed() );
+	jobs.submit( first_group );
+	jobs.wait( second_group );
+	ASSERT( first_group.is_completed() );
+	ASSERT( is_order_respected );
+
+	//	Check that an empty group still waits on its dependencies.
+	std::atomic<bool> is_job_done { false };
+	JobGroup job_group = jobs.run( [&]() { is_job_done = true; } );
+	JobGroup empty_group = jobs.create_group( { job_group } );
+	jobs.submit( empty_group );
+	jobs.wait( empty_group );
+	ASSERT( is_job_done );
+
+	//	Check that jobs added from jobs are waited on by the frame.
+	std::atomic<int> nested_count { 0 };
+	for ( int i = 0; i < 16; i++ )
+	{
+		jobs.run(
+			[&]()
+			{
+				jobs.run( [&]() { nested_count++; } );
+				nested_count++;
+			}
+		);
+	}
+	jobs.wait_frame();
+	ASSERT( nested_count == 32 );
+
+	printf( "UnitTest: JobSystem All Passed!\n" );
+}
@@ -0,0 +1,46 @@
+#include "unit-test-timer-wheel.h"
+
+#include <suprengine/core/timer-wheel.h>
+#include <suprengine/utils/assert.h>
+
+using namespace test;
+using namespace suprengine;
+
+void UnitTestTimerWheel::run()
+{
+	TimerWheel wheel {};
+
+	//	Check that a timer is called once its time is elapsed.
+	int calls_count = 0;
+	TimerHandle handle = wheel.add( Timer( [&] { calls_count++; }, 0.01f ) );
+	wheel.update( 0.005f );
+	ASSERT( calls_count == 0 );
+	wheel.update( 0.0055f );
+	ASSERT( calls_count == 1 );
+	ASSERT( !handle.is_valid() );
+
+	//	Check that a timer paused then resumed keeps its remaining time.
+	handle = wheel.add( Timer( [&] { calls_count++; }, 0.01f ) );
+	wheel.update( 0.0045f );
+	handle.pause();
+	wheel.update( 0.1f );
+	ASSERT( calls_count == 1 );
+	handle.resume();
+	wheel.update( 0.0065f );
+	ASSERT( calls_count == 2 );
+
+	//	Check that a timer paused by another timer due on the same tick
+	//	is called on the next tick after its resume.
+	int paused_calls_count = 0;
+	TimerHandle paused_handle = wheel.add( Timer( [&] { paused_calls_count++; }, 0.01f ) );
+	wheel.add( Timer( [&] { paused_handle.pause(); }, 0.01f ) );
+	wheel.update( 0.0105f );
+	ASSERT( paused_calls_count == 0 );
+	ASSERT( paused_handle.is_paused() );
+	wheel.update( 0.0105f );
+	paused_handle.resume();
+	wheel.update( 0.0015f );
+	ASSERT( paused_calls_count == 1 );
+
+	printf( "UnitTest: TimerWheel All Passed!\n" );
+}
@@ -0,0 +1,9 @@
+
+namespace test
+{
+	class UnitTestTimerWheel
+	{
+	public:
+		void run();
+	};
+}
\ No newline at end of file
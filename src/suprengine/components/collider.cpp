@@ -15,6 +15,7 @@ void Collider::setup()
 	auto physics = engine.get_physics();
 
 	auto ptr = as<Collider>();
+	update_bounds();
 	physics->add_collider( ptr );
 }
 
@@ -27,6 +28,16 @@ void Collider::unsetup()
 	physics->remove_collider( ptr );
 }
 
+void Collider::update_bounds()
+{
+	_bounds = compute_bounds();
+}
+
+const Box& Collider::get_bounds() const
+{
+	return _bounds;
+}
+
 void Collider::update_collision_with( SharedPtr<Collider> other, bool is_active )
 {
 	Collider* other_ptr = other.get();
@@ -53,3 +64,8 @@ void Collider::update_collision_with( SharedPtr<Collider> other, bool is_active
 		}
 	}
 }
+
+bool Collider::is_colliding_with( const Collider* other ) const
+{
+	return collisions.find( const_cast<Collider*>( other ) ) != collisions.end();
+}
@@ -2,6 +2,7 @@
 
 #include <suprengine/core/component.h>
 
+#include <suprengine/math/box.h>
 #include <suprengine/math/color.h>
 
 #include <suprengine/utils/ray.h>
@@ -37,12 +38,40 @@ namespace suprengine
 
 		virtual bool intersects( SharedPtr<Collider> other ) = 0;
 		virtual bool raycast( const Ray& ray, RayHit* hit, const RayParams& params ) = 0;
+		/*
+		 * Compute the axis-aligned bounding box of the collider in world-space.
+		 */
+		virtual Box compute_bounds() const = 0;
 
 		void update_collision_with( SharedPtr<Collider> other, bool active );
+		bool is_colliding_with( const Collider* other ) const;
+
+		/*
+		 * Refresh the cached world-space bounds from the current transform.
+		 * Called by the physics before each broadphase update.
+		 */
+		void update_bounds();
+		/*
+		 * Returns the cached world-space bounds, as computed during the
+		 * last physics update.
+		 */
+		const Box& get_bounds() const;
 	
 	public:
 		uint32_t mask = 0xFFFFFFFF;
 
+		/*
+		 * Identifier of the collider proxy inside the broadphase.
+		 * Only meant to be used by the broadphase implementation.
+		 */
+		int broadphase_proxy_id = INDEX_NONE;
+		/*
+		 * Position of the collider in the physics list, refreshed on each
+		 * update to order collision events deterministically.
+		 * Only meant to be used by the physics.
+		 */
+		int physics_order = INDEX_NONE;
+
 		Color debug_color { 0, 255, 0, 127 };
 
 	public:
@@ -57,5 +86,8 @@ namespace suprengine
 
 	protected:
 		std::set<Collider*> collisions;
+
+	private:
+		Box _bounds {};
 	};
 }
\ No newline at end of file
@@ -92,6 +92,27 @@ bool BoxCollider::raycast( const Ray& ray, RayHit* hit, const RayParams& params
 	return true;
 }
 
+Box BoxCollider::compute_bounds() const
+{
+	const Vec3 min = shape.min * transform->scale;
+	const Vec3 max = shape.max * transform->scale;
+
+	//	Enclose all rotated corners
+	Box bounds { Vec3( math::PLUS_INFINITY ), Vec3( math::NEG_INFINITY ) };
+	for ( int i = 0; i < 8; i++ )
+	{
+		const Vec3 corner {
+			( i & 1 ) ? max.x : min.x,
+			( i & 2 ) ? max.y : min.y,
+			( i & 4 ) ? max.z : min.z,
+		};
+		const Vec3 location = transform->location + Vec3::transform( corner, transform->rotation );
+		bounds = Box::merge( bounds, Box { location, location } );
+	}
+
+	return bounds;
+}
+
 void BoxCollider::debug_render( RenderBatch* render_batch )
 {
 #ifdef ENABLE_VISDEBUG
@@ -15,6 +15,7 @@ namespace suprengine
 		//  TODO: implement this
 		bool intersects( SharedPtr<Collider> other ) override;
 		bool raycast( const Ray& ray, RayHit* hit, const RayParams& params );
+		Box compute_bounds() const override;
 
 		void debug_render( RenderBatch* render_batch ) override;
 	};
@@ -55,6 +55,15 @@ bool SphereCollider::raycast( const Ray& ray, RayHit* hit, const RayParams& para
 	return true;
 }
 
+Box SphereCollider::compute_bounds() const
+{
+	const Vec3 extents( get_scaled_radius() );
+	return Box {
+		transform->location - extents,
+		transform->location + extents
+	};
+}
+
 float SphereCollider::get_scaled_radius() const
 {
 	return radius * transform->scale.x;
@@ -14,6 +14,7 @@ namespace suprengine
 		//  TODO: implement this
 		bool intersects( SharedPtr<Collider> other ) override;
 		bool raycast( const Ray& ray, RayHit* hit, const RayParams& params );
+		Box compute_bounds() const override;
 
 		float get_scaled_radius() const;
 
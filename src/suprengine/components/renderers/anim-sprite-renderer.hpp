@@ -1,6 +1,8 @@
 #pragma once
 #include "sprite-renderer.hpp"
 
+#include <suprengine/utils/flat-hash-map.h>
+
 namespace suprengine
 {
 	struct AnimClip
@@ -14,7 +16,7 @@ namespace suprengine
 	private:
 		float current_time_per_frame { 0.0f };
 	public:
-		std::map<std::string, AnimClip> clips;
+		FlatHashMap<std::string, AnimClip> clips;
 		std::string current_clip { "" };
 
 		std::vector<Rect> frames;
@@ -104,7 +106,8 @@ namespace suprengine
 		{
 			if ( current_clip == clip_name ) return;
 
-			if ( clips.find( clip_name ) == clips.end() )
+			const auto itr = clips.find( clip_name );
+			if ( itr == clips.end() )
 			{
 				Logger::error( "AnimSpriteRenderer: clip '" + clip_name + "' doesn't exists, aborting!" );
 				return;
@@ -113,7 +116,7 @@ namespace suprengine
 			current_clip = clip_name;
 
 			//  update from clip
-			AnimClip& clip = clips[clip_name];
+			const AnimClip& clip = itr->second;
 			if ( clip.time_per_frame > 0.0f )
 			{
 				time_per_frame = clip.time_per_frame;
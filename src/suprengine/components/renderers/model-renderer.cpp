@@ -8,7 +8,7 @@ void ModelRenderer::render( RenderBatch* render_batch )
 {
 	glFrontFace( GL_CW );
 	render_batch->draw_model( 
-		transform->get_matrix(), 
+		transform->get_interpolated_matrix( render_batch->get_interpolation_alpha() ), 
 		model, 
 		shader_name,
 		modulate
@@ -81,4 +81,30 @@ const Mtx4& Transform::get_matrix()
 bool Transform::is_matrix_dirty() const
 {
 	return _is_matrix_dirty;
+}
+
+void Transform::store_previous_state()
+{
+	_previous_location = location;
+	_previous_rotation = rotation;
+	_previous_scale = scale;
+	_has_previous_state = true;
+}
+
+Mtx4 Transform::get_interpolated_matrix( const float alpha )
+{
+	if ( !_has_previous_state || alpha >= 1.0f ) return get_matrix();
+
+	//  Avoid blending transforms which haven't changed since the last tick
+	const bool has_rotation_changed = rotation.x != _previous_rotation.x
+		|| rotation.y != _previous_rotation.y
+		|| rotation.z != _previous_rotation.z
+		|| rotation.w != _previous_rotation.w;
+	if ( location == _previous_location && scale == _previous_scale && !has_rotation_changed ) return get_matrix();
+
+	return Mtx4::create_from_transform(
+		Vec3::lerp( _previous_scale, scale, alpha ),
+		Quaternion::slerp( _previous_rotation, rotation, alpha ),
+		Vec3::lerp( _previous_location, location, alpha )
+	);
 }
\ No newline at end of file
@@ -51,6 +51,20 @@ namespace suprengine
 		const Mtx4& get_matrix();
 		bool is_matrix_dirty() const;
 
+		/*
+		 * Stores the current location, rotation and scale as the previous
+		 * state. Called by the engine before each fixed tick.
+		 * Call it after teleporting the transform to not interpolate the
+		 * teleport.
+		 */
+		void store_previous_state();
+		/*
+		 * Returns the matrix blending the previous state towards the current
+		 * one by the given alpha, see RenderBatch::get_interpolation_alpha.
+		 * Returns the current matrix without a previous state to blend with.
+		 */
+		Mtx4 get_interpolated_matrix( float alpha );
+
 	public:
 		/*
 		 * Location of the transform.
@@ -77,5 +91,10 @@ namespace suprengine
 	private:
 		Mtx4 _matrix {};
 		bool _is_matrix_dirty = true;
+
+		Vec3 _previous_location = Vec3::zero;
+		Quaternion _previous_rotation = Quaternion::identity;
+		Vec3 _previous_scale = Vec3::one;
+		bool _has_previous_state = false;
 	};
 }
\ No newline at end of file
@@ -15,11 +15,11 @@
 
 using namespace suprengine;
 
-std::map<std::string, SharedPtr<Texture>> Assets::_textures;
-std::map<std::string, SharedPtr<Font>> Assets::_fonts;
-std::map<std::string, SharedPtr<ShaderProgram>> Assets::_shader_programs;
-std::map<std::string, SharedPtr<Model>> Assets::_models;
-std::map<std::string, SharedPtr<Curve>> Assets::_curves;
+Assets::AssetsMap<Texture> Assets::_textures;
+Assets::AssetsMap<Font> Assets::_fonts;
+Assets::AssetsMap<ShaderProgram> Assets::_shader_programs;
+Assets::AssetsMap<Model> Assets::_models;
+Assets::AssetsMap<Curve> Assets::_curves;
 
 std::vector<SharedPtr<Assets::filewatcher>> Assets::_filewatchers;
 
@@ -59,17 +59,18 @@ SharedPtr<Texture> Assets::load_texture( rconst_str name, rconst_str path, const
 		params.filtering
 	);
 
-	_textures[name] = _render_batch->load_texture( path, params );
-	return _textures[name];
+	SharedPtr<Texture> texture = _render_batch->load_texture( path, params );
+	_textures[StringId::intern( name )] = texture;
+	return texture;
 }
 
-SharedPtr<Texture> Assets::get_texture( rconst_str name )
+SharedPtr<Texture> Assets::get_texture( const StringId name )
 {
 	//  check texture
 	const auto itr = _textures.find( name );
 	if ( itr == _textures.end() )
 	{
-		Logger::error( "Failed to get texture '" + name + "', either not loaded or the name is wrong!" );
+		Logger::error( "Failed to get texture '%s', either not loaded or the name is wrong!", name.get_string() );
 		return nullptr;
 	}
 
@@ -81,8 +82,9 @@ SharedPtr<Font> Assets::load_font( rconst_str name, rconst_str path, int size )
 {
 	const std::string key = name + std::to_string( size );
 
-	_fonts[key] = Font::load( path, size );
-	return _fonts[key];
+	SharedPtr<Font> font = Font::load( path, size );
+	_fonts[StringId::intern( key )] = font;
+	return font;
 }
 
 SharedPtr<Font> Assets::get_font( rconst_str name, int size )
@@ -90,7 +92,7 @@ SharedPtr<Font> Assets::get_font( rconst_str name, int size )
 	const std::string key = name + std::to_string( size );
 
 	//  check font
-	const auto itr = _fonts.find( key );
+	const auto itr = _fonts.find( StringId( key ) );
 	if ( itr == _fonts.end() )
 	{
 		Logger::error( "Failed to get font '" + key + "', either not loaded or the name is wrong!" );
@@ -106,6 +108,13 @@ SharedPtr<ShaderProgram> Assets::load_shader_program( const ShaderProgramAssetIn
 	ASSERT( !asset_info.name.empty() );
 	ASSERT( !asset_info.shaders.empty() );
 
+	//  Shaders can't be compiled without a graphics backend
+	if ( _render_batch != nullptr && _render_batch->is_headless() )
+	{
+		Logger::info( "Skipping shader program '%s' as the render batch is headless", *asset_info.name );
+		return nullptr;
+	}
+
 	Logger::info(
 		"Loading shader program '%s' with %d shaders",
 		*asset_info.name, asset_info.shaders.size()
@@ -156,16 +165,16 @@ SharedPtr<ShaderProgram> Assets::load_shader_program( const ShaderProgramAssetIn
 	);
 	shader_program->print_all_params();
 
-	_shader_programs[asset_info.name] = shader_program;
+	_shader_programs[StringId::intern( asset_info.name )] = shader_program;
 	return shader_program;
 }
 
-SharedPtr<ShaderProgram> Assets::get_shader_program( rconst_str name )
+SharedPtr<ShaderProgram> Assets::get_shader_program( const StringId name )
 { 
 	const auto itr = _shader_programs.find( name );
 	if ( itr == _shader_programs.end() )
 	{
-		Logger::error( "Failed to get shader program '" + name + "', either not loaded or the name is wrong!" );
+		Logger::error( "Failed to get shader program '%s', either not loaded or the name is wrong!", name.get_string() );
 		return nullptr;
 	}
 
@@ -175,7 +184,7 @@ SharedPtr<ShaderProgram> Assets::get_shader_program( rconst_str name )
 
 SharedPtr<Model> Assets::add_model( rconst_str name, SharedPtr<Model> model )
 {
-	_models[name] = model;
+	_models[StringId::intern( name )] = model;
 	return model;
 }
 
@@ -206,16 +215,16 @@ SharedPtr<Model> Assets::load_model( rconst_str name, rconst_str path, rconst_st
 	SharedPtr<Model> model = std::make_shared<Model>( std::move( meshes ), shader_name );
 	
 	//	Register and return
-	_models[name] = model;
+	_models[StringId::intern( name )] = model;
 	return model;
 }
 
-SharedPtr<Model> Assets::get_model( rconst_str name )
+SharedPtr<Model> Assets::get_model( const StringId name )
 {
 	const auto itr = _models.find( name );
 	if ( itr == _models.end() )
 	{
-		Logger::error( "Failed to get model '%s', either not loaded or the name is wrong!", *name );
+		Logger::error( "Failed to get model '%s', either not loaded or the name is wrong!", name.get_string() );
 		return nullptr;
 	}
 
@@ -316,20 +325,21 @@ SharedPtr<Curve> Assets::load_curve(
 
 	//  Un-serialize curve and store it
 	Curve temporary = _curve_serializer.unserialize( data );
-	_curves[name] = std::make_shared<Curve>( temporary );
+	SharedPtr<Curve> curve = std::make_shared<Curve>( temporary );
+	_curves[StringId::intern( name )] = curve;
 
 	Logger::info( "Registered Curve asset as '" + name + "'." );
-	return _curves[name];
+	return curve;
 }
 
-SharedPtr<Curve> Assets::get_curve( rconst_str name )
+SharedPtr<Curve> Assets::get_curve( const StringId name )
 {
-	if ( name.empty() ) return nullptr;
+	if ( !name.is_valid() || name == StringId( "" ) ) return nullptr;
 
 	auto itr = _curves.find( name );
 	if ( itr == _curves.end() )
 	{
-		Logger::error( "Failed to get curve '" + name + "', either not loaded or the name is wrong!" );
+		Logger::error( "Failed to get curve '%s', either not loaded or the name is wrong!", name.get_string() );
 		return nullptr;
 	}
 
@@ -414,6 +424,9 @@ VertexArray* Assets::load_mesh( const aiMesh* mesh )
 		has_normals ? "true" : "false", has_uvs ? "true" : "false"
 	);
 
+	//  Only keep the mesh itself without a graphics backend
+	if ( _render_batch != nullptr && _render_batch->is_headless() ) return nullptr;
+
 	//  Create vertex array
 	auto vertex_array = new VertexArray(
 		preset,
@@ -7,13 +7,16 @@
 #include <suprengine/rendering/shader.h>
 
 #include <suprengine/utils/curve.h>
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/string-id.h>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 
 #include <filewatch/FileWatch.hpp>
 
-#include <map>
+#include <algorithm>
+#include <string_view>
 
 namespace suprengine
 {
@@ -35,17 +38,17 @@ namespace suprengine
 		static std::string get_path() { return _resources_path; }
 
 		static SharedPtr<Texture> load_texture( rconst_str name, rconst_str path, const TextureParams& params = {} );
-		static SharedPtr<Texture> get_texture( rconst_str name );
+		static SharedPtr<Texture> get_texture( StringId name );
 
 		static SharedPtr<Font> load_font( rconst_str name, rconst_str path, int size = 12 );
 		static SharedPtr<Font> get_font( rconst_str path, int size );
 
 		static SharedPtr<ShaderProgram> load_shader_program( const ShaderProgramAssetInfo& asset_info );
-		static SharedPtr<ShaderProgram> get_shader_program( rconst_str name );
+		static SharedPtr<ShaderProgram> get_shader_program( StringId name );
 
 		static SharedPtr<Model> add_model( rconst_str name, SharedPtr<Model> model );
 		static SharedPtr<Model> load_model( rconst_str name, rconst_str path, rconst_str shader_name = "" );
-		static SharedPtr<Model> get_model( rconst_str name );
+		static SharedPtr<Model> get_model( StringId name );
 
 		static void load_curves_in_folder(
 			rconst_str path,
@@ -57,10 +60,10 @@ namespace suprengine
 			rconst_str name,
 			rconst_str path
 		);
-		static SharedPtr<Curve> get_curve( rconst_str name );
+		static SharedPtr<Curve> get_curve( StringId name );
 
 		/*
-		 * Get a list of all assets identifiers of a given type.
+		 * Get a list of all assets identifiers of a given type, sorted alphabetically.
 		 * Only works with 'std::string' and 'const char*' for IdentifierType.
 		 */
 		template <typename AssetType, typename IdentifierType>
@@ -73,7 +76,7 @@ namespace suprengine
 		{
 			// Create a constexpr lambda to compile the function 
 			// with the map of the given asset type.
-			auto get_related_assets_map = [&]() constexpr -> std::map<std::string, SharedPtr<AssetType>>&
+			auto get_related_assets_map = [&]() constexpr -> AssetsMap<AssetType>&
 			{
 				if constexpr ( std::is_same_v<AssetType, Texture> )
 				{
@@ -106,9 +109,17 @@ namespace suprengine
 
 			for ( auto& pair : assets_map )
 			{
-				assets_as_ids.emplace_back( pair.first.c_str() );
+				assets_as_ids.emplace_back( pair.first.get_string() );
 			}
 
+			// Sort them since the map order is unspecified
+			std::sort( assets_as_ids.begin(), assets_as_ids.end(),
+				[]( const IdentifierType& a, const IdentifierType& b )
+				{
+					return std::string_view( a ) < std::string_view( b );
+				}
+			);
+
 			return assets_as_ids;
 		}
 
@@ -117,11 +128,14 @@ namespace suprengine
 	private:
 		using filewatcher = filewatch::FileWatch<std::string>;
 
-		static std::map<std::string, SharedPtr<Texture>> _textures;
-		static std::map<std::string, SharedPtr<Font>> _fonts;
-		static std::map<std::string, SharedPtr<ShaderProgram>> _shader_programs;
-		static std::map<std::string, SharedPtr<Model>> _models;
-		static std::map<std::string, SharedPtr<Curve>> _curves;
+		template <typename AssetType>
+		using AssetsMap = FlatHashMap<StringId, SharedPtr<AssetType>>;
+
+		static AssetsMap<Texture> _textures;
+		static AssetsMap<Font> _fonts;
+		static AssetsMap<ShaderProgram> _shader_programs;
+		static AssetsMap<Model> _models;
+		static AssetsMap<Curve> _curves;
 
 		static std::vector<SharedPtr<filewatcher>> _filewatchers;
 
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <suprengine/core/component-type.h>
+
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Declaration of the component types a component type reads and
+	 * writes during its update, allowing the engine to update it in parallel.
+	 *
+	 * A component type always writes itself. During its update, a component
+	 * must only access components of its own entity matching the declared types.
+	 *
+	 * Usage, inside the component class:
+	 *
+	 * const ComponentAccess* get_update_access() const override
+	 * {
+	 *     static const ComponentAccess access =
+	 *         ComponentAccess::of<MyComponent>().write<Transform>();
+	 *     return &access;
+	 * }
+	 */
+	class ComponentAccess
+	{
+	public:
+		template <typename TComponent>
+		static ComponentAccess of()
+		{
+			return ComponentAccess( ComponentType::get_id<TComponent>(), typeid( TComponent ).name() );
+		}
+
+		template <typename TComponent>
+		ComponentAccess& read()
+		{
+			_reads.push_back( ComponentType::get_id<TComponent>() );
+			return *this;
+		}
+		template <typename TComponent>
+		ComponentAccess& write()
+		{
+			_writes.push_back( ComponentType::get_id<TComponent>() );
+			return *this;
+		}
+
+		/*
+		 * Returns whenever both component types can't be updated at the
+		 * same time, one of them writing a type the other accesses.
+		 * Types related by inheritance are accessing the same components,
+		 * so writing 'Collider' conflicts with reading 'SphereCollider'.
+		 */
+		bool conflicts_with( const ComponentAccess& other ) const
+		{
+			if ( _type == other._type ) return true;
+
+			for ( const ComponentTypeId type : _writes )
+			{
+				if ( other._accesses( type ) ) return true;
+			}
+			for ( const ComponentTypeId type : other._writes )
+			{
+				if ( _accesses( type ) ) return true;
+			}
+
+			return false;
+		}
+
+		ComponentTypeId get_type() const { return _type; }
+		const char* get_name() const { return _name; }
+
+	private:
+		ComponentAccess( const ComponentTypeId type, const char* name )
+			: _type( type ), _name( name ), _writes { type } {}
+
+		bool _accesses( const ComponentTypeId type ) const
+		{
+			for ( const ComponentTypeId write_type : _writes )
+			{
+				if ( _are_related( write_type, type ) ) return true;
+			}
+			for ( const ComponentTypeId read_type : _reads )
+			{
+				if ( _are_related( read_type, type ) ) return true;
+			}
+
+			return false;
+		}
+
+		static bool _are_related( const ComponentTypeId a, const ComponentTypeId b )
+		{
+			return ComponentType::is_derived_from( a, b ) || ComponentType::is_derived_from( b, a );
+		}
+
+	private:
+		ComponentTypeId _type;
+		const char* _name;
+		std::vector<ComponentTypeId> _reads {};
+		std::vector<ComponentTypeId> _writes {};
+	};
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <suprengine/core/component-type.h>
+#include <suprengine/core/entity-handle.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Type-erased interface of a component pool, used by the registry
+	 * to manage pools regardless of their component type.
+	 */
+	class IComponentPool
+	{
+	public:
+		virtual ~IComponentPool() {}
+
+		virtual bool remove( EntityHandle handle ) = 0;
+		virtual bool has( EntityHandle handle ) const = 0;
+		virtual void clear() = 0;
+
+		virtual int get_size() const = 0;
+	};
+
+	/*
+	 * Data-oriented storage of components of a given type, implemented
+	 * as a sparse set.
+	 * 
+	 * Components are packed contiguously inside a dense vector, which is 
+	 * meant to be iterated by systems, while a sparse vector indexed by
+	 * EntityHandle::index allows constant time lookup, insertion and removal.
+	 * 
+	 * Removing a component moves the last component in its place: pointers
+	 * and references to components are invalidated by any insertion or removal.
+	 */
+	template <typename T>
+	class ComponentPool : public IComponentPool
+	{
+	public:
+		/*
+		 * Construct a component for the given entity.
+		 * Adding a component to an entity which already has one returns
+		 * the existing component.
+		 */
+		template <typename ...TArgs>
+		T& add( const EntityHandle handle, TArgs&& ...args )
+		{
+			ASSERT( !handle.is_null() );
+
+			if ( T* component = find( handle ) ) return *component;
+
+			if ( handle.index >= _sparse.size() )
+			{
+				_sparse.resize( handle.index + 1, INVALID_INDEX );
+			}
+
+			_sparse[handle.index] = static_cast<uint32>( _dense.size() );
+			_owners.push_back( handle );
+			return _dense.emplace_back( std::forward<TArgs>( args )... );
+		}
+
+		bool remove( const EntityHandle handle ) override
+		{
+			if ( !has( handle ) ) return false;
+
+			//	Move the last component in place of the removed one
+			const uint32 index = _sparse[handle.index];
+			const uint32 last_index = static_cast<uint32>( _dense.size() ) - 1;
+			if ( index != last_index )
+			{
+				_dense[index] = std::move( _dense[last_index] );
+				_owners[index] = _owners[last_index];
+				_sparse[_owners[index].index] = index;
+			}
+
+			_dense.pop_back();
+			_owners.pop_back();
+			_sparse[handle.index] = INVALID_INDEX;
+			return true;
+		}
+
+		bool has( const EntityHandle handle ) const override
+		{
+			if ( handle.index >= _sparse.size() ) return false;
+
+			const uint32 index = _sparse[handle.index];
+			return index != INVALID_INDEX && _owners[index] == handle;
+		}
+
+		T* find( const EntityHandle handle )
+		{
+			if ( !has( handle ) ) return nullptr;
+			return &_dense[_sparse[handle.index]];
+		}
+
+		void clear() override
+		{
+			_sparse.clear();
+			_dense.clear();
+			_owners.clear();
+		}
+
+		int get_size() const override
+		{
+			return static_cast<int>( _dense.size() );
+		}
+
+		/*
+		 * Returns the packed components, in the same order as the owners.
+		 */
+		std::vector<T>& get_components() { return _dense; }
+		const std::vector<T>& get_components() const { return _dense; }
+		/*
+		 * Returns the owner handle of each packed component.
+		 */
+		const std::vector<EntityHandle>& get_owners() const { return _owners; }
+
+		typename std::vector<T>::iterator begin() { return _dense.begin(); }
+		typename std::vector<T>::iterator end() { return _dense.end(); }
+
+	private:
+		static constexpr uint32 INVALID_INDEX = static_cast<uint32>( -1 );
+
+	private:
+		std::vector<uint32> _sparse {};
+		std::vector<T> _dense {};
+		std::vector<EntityHandle> _owners {};
+	};
+
+	/*
+	 * Opt-in data-oriented component storage, living next to the Component
+	 * hierarchy. It owns one ComponentPool per stored type.
+	 * 
+	 * Stored types are plain data: they are not Component-derived and are
+	 * neither set up nor updated by the engine. Systems are expected to
+	 * iterate the pools they need, for instance with ComponentRegistry::each.
+	 * 
+	 * Components of an entity are removed when the entity is removed
+	 * from the engine.
+	 */
+	class ComponentRegistry
+	{
+	public:
+		template <typename T>
+		ComponentPool<T>& get_pool()
+		{
+			const ComponentTypeId type_id = ComponentType::get_id<T>();
+			if ( type_id >= _pools.size() )
+			{
+				_pools.resize( type_id + 1 );
+			}
+
+			std::unique_ptr<IComponentPool>& pool = _pools[type_id];
+			if ( pool == nullptr )
+			{
+				pool = std::make_unique<ComponentPool<T>>();
+			}
+
+			return *static_cast<ComponentPool<T>*>( pool.get() );
+		}
+
+		template <typename T, typename ...TArgs>
+		T& add( const EntityHandle handle, TArgs&& ...args )
+		{
+			return get_pool<T>().add( handle, std::forward<TArgs>( args )... );
+		}
+		template <typename T>
+		bool remove( const EntityHandle handle )
+		{
+			return get_pool<T>().remove( handle );
+		}
+		template <typename T>
+		T* find( const EntityHandle handle )
+		{
+			return get_pool<T>().find( handle );
+		}
+		template <typename T>
+		bool has( const EntityHandle handle )
+		{
+			return get_pool<T>().has( handle );
+		}
+
+		/*
+		 * Call the function on each entity owning all the given types, with
+		 * the signature: void( EntityHandle, T&, TOthers&... ).
+		 * 
+		 * The pool of the first type is iterated contiguously while the
+		 * others are looked up, so the first type should be the rarest.
+		 * Pools must not be modified during the iteration.
+		 */
+		template <typename T, typename ...TOthers, typename TFunc>
+		void each( TFunc&& func )
+		{
+			ComponentPool<T>& pool = get_pool<T>();
+			std::tuple<ComponentPool<TOthers>&...> others { get_pool<TOthers>()... };
+
+			std::vector<T>& components = pool.get_components();
+			const std::vector<EntityHandle>& owners = pool.get_owners();
+			for ( size_t i = 0; i < components.size(); i++ )
+			{
+				const EntityHandle handle = owners[i];
+				if constexpr ( sizeof...( TOthers ) == 0 )
+				{
+					func( handle, components[i] );
+				}
+				else
+				{
+					if ( !( std::get<ComponentPool<TOthers>&>( others ).has( handle ) && ... ) ) continue;
+
+					func(
+						handle, components[i],
+						*std::get<ComponentPool<TOthers>&>( others ).find( handle )...
+					);
+				}
+			}
+		}
+
+		/*
+		 * Remove all components owned by the given entity.
+		 */
+		void remove_all( const EntityHandle handle )
+		{
+			for ( const std::unique_ptr<IComponentPool>& pool : _pools )
+			{
+				if ( pool == nullptr ) continue;
+				pool->remove( handle );
+			}
+		}
+
+		void clear()
+		{
+			for ( const std::unique_ptr<IComponentPool>& pool : _pools )
+			{
+				if ( pool == nullptr ) continue;
+				pool->clear();
+			}
+		}
+
+	private:
+		/*
+		 * Pools indexed by ComponentTypeId.
+		 */
+		std::vector<std::unique_ptr<IComponentPool>> _pools {};
+	};
+}
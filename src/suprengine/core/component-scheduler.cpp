@@ -0,0 +1,117 @@
+#include "component-scheduler.h"
+
+#include <suprengine/core/component.h>
+#include <suprengine/core/job-system.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+
+using namespace suprengine;
+
+void ComponentScheduler::add( Component* component )
+{
+	const ComponentAccess* access = component->get_update_access();
+	ASSERT( access != nullptr );
+
+	//  Find the bucket of its type or create it
+	auto itr = _bucket_indices.find( access->get_type() );
+	if ( itr == _bucket_indices.end() )
+	{
+		itr = _bucket_indices.emplace( access->get_type(), static_cast<int>( _buckets.size() ) ).first;
+		_buckets.push_back( TypeBucket { access } );
+		_is_dirty = true;
+	}
+
+	_buckets[itr->second].components.push_back( component );
+}
+
+void ComponentScheduler::update( JobSystem* jobs, const float dt )
+{
+	if ( _is_dirty )
+	{
+		_build_batches();
+	}
+
+	const int workers_count = jobs->get_workers_count();
+	for ( const std::vector<int>& batch : _batches )
+	{
+		JobGroup group = jobs->create_group();
+
+		for ( const int bucket_index : batch )
+		{
+			std::vector<Component*>& components = _buckets[bucket_index].components;
+			const int count = static_cast<int>( components.size() );
+			if ( count == 0 ) continue;
+
+			//  Split the components in a few jobs per worker
+			const int jobs_size = std::max( 1, count / ( workers_count * 4 ) );
+			for ( int begin = 0; begin < count; begin += jobs_size )
+			{
+				const int end = std::min( begin + jobs_size, count );
+				jobs->add_job( group,
+					[&components, begin, end, dt]()
+					{
+						for ( int i = begin; i < end; i++ )
+						{
+							components[i]->update( dt );
+						}
+					}
+				);
+			}
+		}
+
+		jobs->submit( group );
+		jobs->wait( group );
+	}
+
+	//  Clear queued components while keeping the memory for the next update
+	for ( TypeBucket& bucket : _buckets )
+	{
+		bucket.components.clear();
+	}
+}
+
+int ComponentScheduler::get_types_count() const
+{
+	return static_cast<int>( _buckets.size() );
+}
+
+int ComponentScheduler::get_batches_count() const
+{
+	return static_cast<int>( _batches.size() );
+}
+
+void ComponentScheduler::_build_batches()
+{
+	_batches.clear();
+
+	//  Put each type into the first batch it doesn't conflict with
+	for ( int bucket_index = 0; bucket_index < static_cast<int>( _buckets.size() ); bucket_index++ )
+	{
+		const ComponentAccess* access = _buckets[bucket_index].access;
+
+		std::vector<int>* target_batch = nullptr;
+		for ( std::vector<int>& batch : _batches )
+		{
+			const bool has_conflict = std::any_of( batch.begin(), batch.end(),
+				[&]( const int other_index )
+				{
+					return access->conflicts_with( *_buckets[other_index].access );
+				}
+			);
+			if ( has_conflict ) continue;
+
+			target_batch = &batch;
+			break;
+		}
+
+		if ( target_batch == nullptr )
+		{
+			target_batch = &_batches.emplace_back();
+		}
+		target_batch->push_back( bucket_index );
+	}
+
+	_is_dirty = false;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <suprengine/core/component-access.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace suprengine
+{
+	class Component;
+	class JobSystem;
+
+	/*
+	 * Updates components declaring their ComponentAccess in parallel.
+	 *
+	 * Component types are split into batches of types not conflicting with
+	 * each other. Batches are updated one after another while all components
+	 * of a batch are updated in parallel.
+	 */
+	class ComponentScheduler
+	{
+	public:
+		/*
+		 * Queue a component for the next update.
+		 * The component must declare its update access.
+		 */
+		void add( Component* component );
+		/*
+		 * Update the queued components and clear them.
+		 */
+		void update( JobSystem* jobs, float dt );
+
+		int get_types_count() const;
+		int get_batches_count() const;
+
+	private:
+		struct TypeBucket
+		{
+			const ComponentAccess* access = nullptr;
+			std::vector<Component*> components {};
+		};
+
+	private:
+		void _build_batches();
+
+	private:
+		std::vector<TypeBucket> _buckets {};
+		/*
+		 * Indices of the buckets by the type declaring their access.
+		 */
+		std::unordered_map<ComponentTypeId, int> _bucket_indices {};
+
+		/*
+		 * Indices of the buckets updated at the same time.
+		 */
+		std::vector<std::vector<int>> _batches {};
+		bool _is_dirty = false;
+	};
+}
@@ -0,0 +1,136 @@
+#include "component-type.h"
+
+#include <suprengine/utils/assert.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace suprengine;
+
+static std::mutex types_mutex {};
+static std::unordered_map<std::type_index, ComponentTypeId> types_ids {};
+
+/*
+ * Functions throwing and catching pointers of each type, indexed by the
+ * type identifier. They are only known for types registered statically.
+ */
+struct TypeProbes
+{
+	void ( *thrower )() = nullptr;
+	bool ( *catcher )( void ( * )() ) = nullptr;
+};
+static std::vector<TypeProbes> types_probes {};
+static std::atomic<ComponentTypeId> resolvable_types_count { 0 };
+
+/*
+ * Bit matrices of the relationships between types, indexed by the type
+ * identifier then the base identifier. A relationship is known once its
+ * bit is set in the first matrix, and derived if also set in the second.
+ */
+constexpr std::size_t RELATIONS_WORDS_COUNT = 
+	ComponentType::MAX_CACHED_TYPES_COUNT * ComponentType::MAX_CACHED_TYPES_COUNT / 64;
+static std::atomic<uint64> known_relations[RELATIONS_WORDS_COUNT] {};
+static std::atomic<uint64> derived_relations[RELATIONS_WORDS_COUNT] {};
+
+static ComponentTypeId find_or_add_type( const std::type_index type )
+{
+	const auto itr = types_ids.find( type );
+	if ( itr != types_ids.end() ) return itr->second;
+
+	const ComponentTypeId id = static_cast<ComponentTypeId>( types_ids.size() );
+	types_ids.emplace( type, id );
+	return id;
+}
+
+ComponentTypeId ComponentType::get_id( const std::type_index type )
+{
+	std::lock_guard lock( types_mutex );
+	return find_or_add_type( type );
+}
+
+ComponentTypeId ComponentType::_register_type( const std::type_index type, const PointerThrower thrower, const PointerCatcher catcher )
+{
+	std::lock_guard lock( types_mutex );
+
+	const ComponentTypeId id = find_or_add_type( type );
+	if ( types_probes.size() <= id )
+	{
+		types_probes.resize( id + 1 );
+	}
+	types_probes[id] = TypeProbes { thrower, catcher };
+
+	//  Advance past the leading types having their probes
+	ComponentTypeId count = resolvable_types_count.load( std::memory_order_relaxed );
+	while ( count < types_probes.size() && types_probes[count].thrower != nullptr )
+	{
+		count++;
+	}
+	resolvable_types_count.store( count, std::memory_order_release );
+
+	return id;
+}
+
+bool ComponentType::is_derived_from( const ComponentTypeId type_id, const ComponentTypeId base_id )
+{
+	if ( type_id == base_id ) return true;
+
+	const RelationState state = _get_relation( type_id, base_id );
+	if ( state != RelationState::Unknown ) return state == RelationState::Derived;
+
+	TypeProbes type_probes {}, base_probes {};
+	{
+		std::lock_guard lock( types_mutex );
+		if ( type_id < types_probes.size() )
+		{
+			type_probes = types_probes[type_id];
+		}
+		if ( base_id < types_probes.size() )
+		{
+			base_probes = types_probes[base_id];
+		}
+	}
+	ASSERT( type_probes.thrower != nullptr && base_probes.catcher != nullptr );
+	if ( type_probes.thrower == nullptr || base_probes.catcher == nullptr ) return false;
+
+	const bool is_derived = base_probes.catcher( type_probes.thrower );
+	_set_relation( type_id, base_id, is_derived );
+	return is_derived;
+}
+
+int ComponentType::get_types_count()
+{
+	std::lock_guard lock( types_mutex );
+	return static_cast<int>( types_ids.size() );
+}
+
+ComponentTypeId ComponentType::get_resolvable_types_count()
+{
+	return resolvable_types_count.load( std::memory_order_acquire );
+}
+
+ComponentType::RelationState ComponentType::_get_relation( const ComponentTypeId type_id, const ComponentTypeId base_id )
+{
+	if ( type_id >= MAX_CACHED_TYPES_COUNT || base_id >= MAX_CACHED_TYPES_COUNT ) return RelationState::Unknown;
+
+	const std::size_t bit = static_cast<std::size_t>( type_id ) * MAX_CACHED_TYPES_COUNT + base_id;
+	const uint64 mask = uint64 { 1 } << ( bit % 64 );
+	if ( ( known_relations[bit / 64].load( std::memory_order_acquire ) & mask ) == 0 ) return RelationState::Unknown;
+
+	const bool is_derived = ( derived_relations[bit / 64].load( std::memory_order_relaxed ) & mask ) != 0;
+	return is_derived ? RelationState::Derived : RelationState::Unrelated;
+}
+
+void ComponentType::_set_relation( const ComponentTypeId type_id, const ComponentTypeId base_id, const bool is_derived )
+{
+	if ( type_id >= MAX_CACHED_TYPES_COUNT || base_id >= MAX_CACHED_TYPES_COUNT ) return;
+
+	const std::size_t bit = static_cast<std::size_t>( type_id ) * MAX_CACHED_TYPES_COUNT + base_id;
+	const uint64 mask = uint64 { 1 } << ( bit % 64 );
+	if ( is_derived )
+	{
+		derived_relations[bit / 64].fetch_or( mask, std::memory_order_relaxed );
+	}
+	known_relations[bit / 64].fetch_or( mask, std::memory_order_release );
+}
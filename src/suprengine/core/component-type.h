@@ -0,0 +1,124 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <typeindex>
+
+namespace suprengine
+{
+	class Component;
+
+	using ComponentTypeId = uint32;
+
+	/*
+	 * Issues dense identifiers to component types, starting from 0.
+	 * 
+	 * The identifier of a type is assigned on its first use and is then
+	 * cached per type, so ComponentType::get_id<T> only costs a static read.
+	 */
+	class ComponentType
+	{
+	public:
+		/*
+		 * Amount of types whose inheritance relationships are cached,
+		 * relationships of types past it are resolved at each query.
+		 */
+		static constexpr ComponentTypeId MAX_CACHED_TYPES_COUNT = 256;
+		/*
+		 * Identifier of no type.
+		 */
+		static constexpr ComponentTypeId INVALID_ID = ~ComponentTypeId { 0 };
+
+	public:
+		template <typename T>
+		static ComponentTypeId get_id()
+		{
+			static const ComponentTypeId id = _register_type( typeid( T ), &_throw_pointer<T>, &_catch_pointer<T> );
+			return id;
+		}
+		/*
+		 * Returns the identifier of a type, from its run-time type.
+		 * Thread-safe.
+		 */
+		static ComponentTypeId get_id( std::type_index type );
+
+		static int get_types_count();
+		/*
+		 * Returns the amount of leading identifiers whose types have all been
+		 * registered with the template 'get_id', so that their relationships
+		 * can be resolved without instances.
+		 * Thread-safe and lock-free.
+		 */
+		static ComponentTypeId get_resolvable_types_count();
+
+		/*
+		 * Returns whenever a component, of given type identifier, derives
+		 * from TBase. The relationship between both types is resolved 
+		 * with a dynamic_cast on its first query, then cached, so later
+		 * queries only cost a table read.
+		 * Thread-safe.
+		 */
+		/*
+		 * Returns whenever a type derives from, or is, the base type, both
+		 * given by identifier. It doesn't need any instance, as a null pointer
+		 * to the type is thrown and caught as a pointer to the base type,
+		 * which only succeeds for public bases. This is only done on the
+		 * first query, then cached.
+		 * Both types must have been registered with the template 'get_id'.
+		 * Thread-safe.
+		 */
+		static bool is_derived_from( ComponentTypeId type_id, ComponentTypeId base_id );
+
+		template <typename TBase>
+		static bool is_derived_from( const ComponentTypeId type_id, const Component* component )
+		{
+			const ComponentTypeId base_id = get_id<TBase>();
+			if ( type_id == base_id ) return true;
+
+			const RelationState state = _get_relation( type_id, base_id );
+			if ( state != RelationState::Unknown ) return state == RelationState::Derived;
+
+			const bool is_derived = dynamic_cast<const TBase*>( component ) != nullptr;
+			_set_relation( type_id, base_id, is_derived );
+			return is_derived;
+		}
+
+	private:
+		enum class RelationState
+		{
+			Unknown,
+			Derived,
+			Unrelated,
+		};
+
+		using PointerThrower = void (*)();
+		using PointerCatcher = bool (*)( PointerThrower );
+
+	private:
+		static ComponentTypeId _register_type( std::type_index type, PointerThrower thrower, PointerCatcher catcher );
+
+		template <typename T>
+		static void _throw_pointer()
+		{
+			throw static_cast<T*>( nullptr );
+		}
+		template <typename T>
+		static bool _catch_pointer( const PointerThrower thrower )
+		{
+			try
+			{
+				thrower();
+			}
+			catch ( const T* )
+			{
+				return true;
+			}
+			catch ( ... ) {}
+
+			return false;
+		}
+
+		static RelationState _get_relation( ComponentTypeId type_id, ComponentTypeId base_id );
+		static void _set_relation( ComponentTypeId type_id, ComponentTypeId base_id, bool is_derived );
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <suprengine/core/component-access.h>
+
+#include <suprengine/utils/pool-allocator.h>
 #include <suprengine/utils/shareable.h>
 
 #include <suprengine/tools/memory-profiler.h>
@@ -25,19 +28,53 @@ namespace suprengine
 		virtual void setup() {}
 		virtual void unsetup() {}
 
+		/*
+		 * Called each frame by the engine, only if the component type
+		 * overrides it.
+		 * 
+		 * Update order contract, for each frame:
+		 * 1. Components of all entities, grouped by type and in descending
+		 *    priority order. Components of an entity are thus not updated
+		 *    next to each other anymore.
+		 * 2. Entity::update_this of all entities, so a component sees the
+		 *    state its entity had at the end of the previous frame.
+		 * 3. Components declaring their access, in parallel.
+		 */
 		virtual void update( float dt ) {}
 		virtual void debug_render( RenderBatch* _render_batch ) {}
 
+		/*
+		 * Returns the component types this component type reads and
+		 * writes during its update.
+		 * When declared, the engine updates the component in parallel
+		 * with others, after the sequential updates of the entities.
+		 * By default, returns nullptr: the component is updated
+		 * sequentially, with the other components of its type.
+		 */
+		virtual const ComponentAccess* get_update_access() const { return nullptr; }
+
 		SharedPtr<Entity> get_owner() const;
 		int get_priority_order() const;
+		/*
+		 * Returns whenever the component type overrides Component::update.
+		 * Components which don't tick are never updated by the engine.
+		 */
+		bool is_ticking() const { return _is_ticking; }
+		/*
+		 * Returns the identifier of the component type, cached once the
+		 * component has been added to an entity.
+		 */
+		ComponentTypeId get_type_id() const { return _type_id; }
 
 	public:
-	#ifdef ENABLE_MEMORY_PROFILER
 		static void* operator new( std::size_t bytes )
 		{
-			return MemoryProfiler::allocate( "Component", bytes );
+			return PoolAllocator::allocate( "Component", bytes );
+		}
+		static void operator delete( void* pointer, std::size_t bytes )
+		{
+			PoolAllocator::deallocate( "Component", pointer, bytes );
 		}
-	#endif
 		
 	public:
 		/*
@@ -55,6 +92,23 @@ namespace suprengine
 	private:
 		int _priority_order;
 
+		/*
+		 * Set from the static type when created through Entity::create_component,
+		 * assumed ticking otherwise.
+		 */
+		bool _is_ticking = true;
+		/*
+		 * Set from the static type when created through Entity::create_component,
+		 * from the run-time type when added to an entity otherwise.
+		 */
+		ComponentTypeId _type_id = ComponentType::INVALID_ID;
+		/*
+		 * Location inside the engine tick lists. While waiting to be added
+		 * to a tick list, only the tick index is set, inside the pending ones.
+		 */
+		int _tick_list_index = INDEX_NONE;
+		int _tick_index = INDEX_NONE;
+
 		/*
 		 * Weak reference to the entity owner.
 		 * It must be a weak pointer because a shared pointer would
@@ -62,5 +116,18 @@ namespace suprengine
 		 * deletion inside the memory.
 		 */
 		WeakPtr<Entity> _owner;
+
+		friend class Engine;
+		friend class Entity;
+		friend class EntityCommandBuffer;
 	};
+
+	/*
+	 * Whenever a component type overrides Component::update.
+	 */
+	template <typename TComponent>
+	constexpr bool is_component_ticking_v = !std::is_same_v<
+		decltype( &TComponent::update ),
+		void ( Component::* )( float )
+	>;
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <suprengine/core/entity.h>
 #include <suprengine/core/scene.h>
 
+#include <suprengine/rendering/null/null-render-batch.h>
+
 #include <suprengine/tools/profiler.h>
 #include <suprengine/tools/vis-debug.h>
 
@@ -17,6 +19,9 @@ using namespace suprengine;
 
 Engine::~Engine()
 {
+	//  Release jobs, waiting on the remaining ones
+	_jobs.reset( nullptr );
+
 	clear_entities();
 
 	//  Release game
@@ -58,12 +63,15 @@ static void custom_imgui_free( void* pointer, void* user_data )
 }
 #endif
 
-bool Engine::init( IGame* game )
+bool Engine::init( IGame* game, const EngineInfos& infos )
 {
+	Profiler::set_thread_name( "Main" );
 	PROFILE_SCOPE( "Engine::init" );
 
-	//	Init SDL
-	const int sdl_status = SDL_Init( SDL_INIT_VIDEO );
+	_is_headless = infos.is_headless;
+
+	//	Init SDL, only listening to quit requests when headless
+	const int sdl_status = SDL_Init( _is_headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO );
 	ASSERT_MSG( sdl_status == 0, SDL_GetError() );
 
 	//	Setup game
@@ -72,23 +80,57 @@ bool Engine::init( IGame* game )
 
 	//  Init window
 	{
-		const GameInfos infos = _game->get_infos();
+		const GameInfos game_infos = _game->get_infos();
 		PROFILE_SCOPE( "Engine::init::Window" );
 
-		_window = std::make_unique<Window>( infos.window );
+		_window = std::make_unique<Window>( game_infos.window, _is_headless );
 	}
 
 	//  Init render batch
 	{
 		PROFILE_SCOPE( "Engine::init::RenderBatch" );
 
-		_render_batch = std::unique_ptr<RenderBatch>(
-			game->create_render_batch( get_window() ) 
-		);
+		if ( _is_headless )
+		{
+			_render_batch = std::make_unique<NullRenderBatch>( get_window() );
+			game->set_render_batch( _render_batch.get() );
+		}
+		else
+		{
+			_render_batch = std::unique_ptr<RenderBatch>(
+				game->create_render_batch( get_window() ) 
+			);
+		}
 		_render_batch->init();
 	}
 
+	//  Run as fast as possible when headless
+	if ( _is_headless )
+	{
+		_updater.is_fps_capped = false;
+	}
+
+	//  Setup benchmark run
+	if ( infos.benchmark_frames_count > 0 )
+	{
+		_benchmark_report = std::make_unique<BenchmarkReport>( infos.benchmark_frames_count, infos.benchmark_delta_time );
+		_benchmark_report_path = infos.benchmark_report_path;
+		_benchmark_delta_time = infos.benchmark_delta_time;
+
+		_updater.is_fps_capped = false;
+		_render_batch->set_vsync( VSyncMode::Disabled );
+	}
+
+	//  Capture first frames
+	if ( infos.trace_frames_count > 0 )
+	{
+		_profiler.start_trace( infos.trace_frames_count, infos.trace_path );
+	}
+
 	//  Init managers
+	_frame_arena = std::make_unique<FrameArena>( "Frame Arena", infos.frame_arena_capacity );
+	_jobs = std::make_unique<JobSystem>();
+	_command_buffers.resize( _jobs->get_workers_count() );
 	_inputs = std::make_unique<InputManager>();
 	_physics = std::make_unique<Physics>();
 
@@ -100,6 +142,8 @@ bool Engine::init( IGame* game )
 		_game->init();
 	}
 
+	if ( _is_headless ) return true;
+
 	//  Init imgui
 	{
 		PROFILE_SCOPE( "Engine::init::ImGui" );
@@ -126,8 +170,18 @@ bool Engine::init( IGame* game )
 
 void Engine::loop()
 {
+	if ( _benchmark_report != nullptr )
+	{
+		_benchmark_report->start();
+	}
+
 	while ( _is_running )
 	{
+		const auto frame_start_time = chrono::steady_clock::now();
+
+		//  Release temporary allocations of the previous frame
+		_frame_arena->reset();
+
 		{
 			PROFILE_SCOPE( "Engine::loop" );
 
@@ -137,6 +191,19 @@ void Engine::loop()
 				_updater.compute_delta_time();
 				float dt = _updater.get_scaled_delta_time();
 
+				//  The fixed timestep caps the late time by itself, with its
+				//  maximum amount of ticks per frame
+				if ( _updater.is_fixed_timestep )
+				{
+					dt = _updater.get_unclamped_delta_time() * _updater.time_scale;
+				}
+
+				//  Benchmarks run with a fixed delta time for reproducible results
+				if ( _benchmark_report != nullptr )
+				{
+					dt = _benchmark_delta_time;
+				}
+
 				//  Apply time scale modifiers
 				//  NOTE: This won't affect result returned by 
 				//  Update::get_scaled_delta_time.
@@ -146,8 +213,32 @@ void Engine::loop()
 				}
 
 				process_input();
-				update( dt );
-				render();
+
+				//  Simulate by fixed ticks, independently from the frame rate
+				//  NOTE: Time scale and pause only affect the amount of ticks.
+				if ( _updater.is_fixed_timestep )
+				{
+					const int ticks_count = _updater.compute_fixed_ticks( dt );
+					for ( int i = 0; i < ticks_count; i++ )
+					{
+						_store_previous_transforms();
+						update( _updater.fixed_delta_time );
+					}
+
+					dt = ticks_count * _updater.fixed_delta_time;
+				}
+				else
+				{
+					update( dt );
+				}
+
+				render( _updater.get_interpolation_alpha() );
+
+				//  Ensure no job outlives the frame
+				{
+					PROFILE_SCOPE( "Engine::loop::wait_jobs" );
+					_jobs->wait_frame();
+				}
 
 				_updater.accumulate_seconds( dt );
 			}
@@ -155,25 +246,63 @@ void Engine::loop()
 			_updater.delay_time();
 		}
 
+	#ifdef ENABLE_MEMORY_PROFILER
+		MemoryProfiler::update();
+	#endif
 		_profiler.update();
+
+		//  Quit once all benchmarked frames are run
+		if ( _benchmark_report != nullptr )
+		{
+			const float frame_time = chrono::duration<float, std::milli>( chrono::steady_clock::now() - frame_start_time ).count();
+			_benchmark_report->add_frame_time( frame_time );
+
+			if ( _benchmark_report->is_finished() )
+			{
+				_is_running = false;
+			}
+		}
 	}
+
+	//  Report before releasing the game
+	if ( _benchmark_report != nullptr )
+	{
+		_benchmark_report->write( _benchmark_report_path );
+	}
+
+	//  Write the trace of frames captured before quitting
+	_profiler.stop_trace();
 }
 
 void Engine::add_entity( const SharedPtr<Entity>& entity )
 {
+	if ( _is_updating_in_parallel )
+	{
+		get_command_buffer()->add_entity( entity );
+		return;
+	}
+
+	//  Ignore an already added entity
+	if ( is_entity_valid( entity->get_handle() ) ) return;
+
+	const EntityHandle handle = _allocate_entity_slot( entity.get() );
+	entity->_handle = handle;
+
 	//  Add to pending entities if currently updating...
+	EntitySlot& slot = _entity_slots[handle.index];
 	if ( _is_updating )
 	{
-		if ( std::find( _pending_entities.begin(), _pending_entities.end(), entity ) != _pending_entities.end() ) return;
-		
+		slot.is_pending = true;
+		slot.dense_index = static_cast<int>( _pending_entities.size() );
 		_pending_entities.push_back( entity );
 	}
 	//  Otherwise, add directly to active entities
 	else
 	{
-		if ( std::find( _entities.begin(), _entities.end(), entity ) != _entities.end() ) return;
-
+		slot.is_pending = false;
+		slot.dense_index = static_cast<int>( _entities.size() );
 		_entities.push_back( entity );
+		_add_entity_to_tick_lists( entity.get() );
 
 		on_entity_added.invoke( entity );
 	}
@@ -181,40 +310,106 @@ void Engine::add_entity( const SharedPtr<Entity>& entity )
 
 void Engine::remove_entity( const SharedPtr<Entity>& entity )
 {
-	//  Remove from actives
-	auto itr = std::find( _entities.begin(), _entities.end(), entity );
-	if ( itr != _entities.end() )
+	const EntityHandle handle = entity->get_handle();
+	if ( !is_entity_valid( handle ) ) return;
+
+	if ( !_entity_slots[handle.index].is_pending )
 	{
 		on_entity_removed.invoke( entity.get() );
-
-		std::iter_swap( itr, _entities.end() - 1 );
-		_entities.pop_back();
-		return;
+		_remove_entity_from_tick_lists( entity.get() );
 	}
 
-	//  Remove from pendings
-	itr = std::find( _pending_entities.begin(), _pending_entities.end(), entity );
-	if ( itr != _pending_entities.end() )
+	//  Swap with the last entity to remove in constant time
+	//  NOTE: Slot is retrieved after the event as listeners may add entities.
+	const EntitySlot& slot = _entity_slots[handle.index];
+	std::vector<SharedPtr<Entity>>& entities = slot.is_pending ? _pending_entities : _entities;
+	const int index = slot.dense_index;
+	if ( index != static_cast<int>( entities.size() ) - 1 )
 	{
-		std::iter_swap( itr, _pending_entities.end() - 1 );
-		_pending_entities.pop_back();
+		SharedPtr<Entity>& last_entity = entities.back();
+		_entity_slots[last_entity->get_handle().index].dense_index = index;
+		entities[index] = std::move( last_entity );
 	}
+	entities.pop_back();
+
+	_component_registry.remove_all( handle );
+	_free_entity_slot( handle );
 }
 
 void Engine::clear_entities()
 {
+	//  Invalidate all handles
+	for ( uint32 index = 0; index < _entity_slots.size(); index++ )
+	{
+		if ( _entity_slots[index].entity == nullptr ) continue;
+		_free_entity_slot( EntityHandle { index, _entity_slots[index].generation } );
+	}
+
 	//  Clear entities
 	_pending_entities.clear();
 	_entities.clear();
 	_dead_entities.clear();
+	_component_registry.clear();
+	_clear_tick_lists();
 
 	//  Clear cameras
 	_cameras.clear();
+
+	//  Recycle pooled memory of released entities and components
+	PoolAllocator::reset();
+}
+
+bool Engine::is_entity_valid( const EntityHandle handle ) const
+{
+	if ( handle.index >= _entity_slots.size() ) return false;
+
+	const EntitySlot& slot = _entity_slots[handle.index];
+	return slot.generation == handle.generation && slot.entity != nullptr;
+}
+
+Entity* Engine::get_entity( const EntityHandle handle ) const
+{
+	if ( !is_entity_valid( handle ) ) return nullptr;
+	return _entity_slots[handle.index].entity;
+}
+
+int Engine::get_entities_count() const
+{
+	return static_cast<int>( _entities.size() + _pending_entities.size() );
+}
+
+int Engine::get_ticking_components_count() const
+{
+	int count = 0;
+	for ( const TickList& list : _tick_lists )
+	{
+		count += static_cast<int>( list.components.size() );
+	}
+
+	return count;
 }
 
-void Engine::add_timer( const Timer& timer )
+EntityCommandBuffer* Engine::get_command_buffer()
 {
-	_timers.emplace_back( timer );
+	const int worker_index = _jobs->get_current_worker_index();
+	ASSERT_MSG( worker_index != INDEX_NONE, "Command buffers are only available to job system workers!" );
+
+	return &_command_buffers[worker_index];
+}
+
+void Engine::flush_command_buffer( EntityCommandBuffer* buffer )
+{
+	_flush_command_buffers( buffer, 1 );
+}
+
+TimerHandle Engine::add_timer( const Timer& timer )
+{
+	return _timers.add( timer );
+}
+
+TimerWheel* Engine::get_timers()
+{
+	return &_timers;
 }
 
 void Engine::add_camera( const SharedPtr<Camera> camera )
@@ -241,10 +436,29 @@ bool Engine::is_running() const
 	return _is_running;
 }
 
+void Engine::quit()
+{
+	_is_running = false;
+}
+
 void Engine::process_input()
 {
 	_inputs->update();
 
+	//  Only listen to quit requests, e.g. on interruption, when headless
+	if ( _is_headless )
+	{
+		SDL_Event event;
+		while ( SDL_PollEvent( &event ) )
+		{
+			if ( event.type != SDL_QUIT ) continue;
+
+			_is_running = false;
+			return;
+		}
+		return;
+	}
+
 	const ImGuiIO& imgui_io = ImGui::GetIO();
 
 	// TODO: Think of a way to avoid the engine directly modifying systems data (i.e. encapsulation)
@@ -342,16 +556,14 @@ void Engine::update( const float dt )
 {
 	PROFILE_SCOPE( "Engine::update" );
 
+	//  Apply commands recorded since the last update
+	_flush_command_buffers( _command_buffers.data(), static_cast<int>( _command_buffers.size() ) );
+
 	//  Add pending entities to active
 	if ( !_pending_entities.empty() )
 	{
 		PROFILE_SCOPE( "Engine::update::pending_entities" );
-
-		for ( auto& entity : _pending_entities )
-		{
-			add_entity( entity );
-		}
-		_pending_entities.clear();
+		_activate_pending_entities();
 	}
 
 	//  Update scene
@@ -362,14 +574,23 @@ void Engine::update( const float dt )
 		_scene->update( dt );
 	}
 
+	//  Update components
+	{
+		PROFILE_SCOPE( "Engine::update::components" );
+		_update_tick_lists( dt );
+	}
+
 	//  Update entities
 	{
 		PROFILE_SCOPE( "Engine::update::entities" );
 		for ( auto& entity : _entities )
 		{
+			//  Index component types registered since the last frame
+			entity->_refresh_components_index();
+
 			if ( entity->state == EntityState::Active )
 			{
-				entity->update( dt );
+				entity->update_this( dt );
 			}
 
 			//  Queue dead entity for later erase
@@ -379,50 +600,26 @@ void Engine::update( const float dt )
 			}
 		}
 	}
+
+	//  Update components declaring their access in parallel
+	{
+		PROFILE_SCOPE( "Engine::update::parallel_components" );
+
+		_is_updating_in_parallel = true;
+		_component_scheduler.update( _jobs.get(), dt );
+		_is_updating_in_parallel = false;
+
+		_flush_command_buffers( _command_buffers.data(), static_cast<int>( _command_buffers.size() ) );
+	}
 	_is_updating = false;
 
 	//  Update colliders
 	_physics->update();
 
-	if ( !_timers.empty() )
+	//  Update timers
 	{
 		PROFILE_SCOPE( "Engine::update::timers" );
-
-		//  Update timers
-		auto itr = _timers.begin();
-		for ( itr; itr != _timers.end(); )
-		{
-			auto& timer = *itr;
-
-			//	Increment timer until it exceeds the maximum time
-			if ( ( timer.current_time += dt ) < timer.max_time )
-			{
-				itr++;
-				continue;
-			}
-			
-			//	Call timer's function
-			timer.callback();
-
-			//	Check if timer has repetitions
-			//	NOTE: This condition allows to have infinite looping timers.
-			if ( timer.repetitions > 0 )
-			{
-				//	Delete timer if repetitions reached zero
-				timer.repetitions--;
-				if ( timer.repetitions == 0 )
-				{
-					itr = _timers.erase( itr );
-					continue;
-				}
-			}
-
-			//	Reset timer's time
-			//	NOTE: Substracting maximum time for more accurate results at higher delta time
-			timer.current_time -= timer.max_time;
-
-			itr++;
-		}
+		_timers.update( dt );
 	}
 
 	if ( !_dead_entities.empty() )
@@ -438,11 +635,14 @@ void Engine::update( const float dt )
 	}
 }
 
-void Engine::render()
+void Engine::render( const float interpolation_alpha )
 {
 	PROFILE_SCOPE( "Engine::render" );
 
+	_render_batch->set_interpolation_alpha( interpolation_alpha );
+
 	//  Update ImGui
+	if ( !_is_headless )
 	{
 		PROFILE_SCOPE( "Engine::render::UpdateImGui" );
 		_render_batch->begin_imgui_frame();
@@ -482,3 +682,428 @@ void Engine::render()
 	//  End rendering
 	_render_batch->end_render();
 }
+
+EntityHandle Engine::_allocate_entity_slot( Entity* entity )
+{
+	uint32 index = 0;
+	if ( _free_entity_slots.empty() )
+	{
+		index = static_cast<uint32>( _entity_slots.size() );
+		_entity_slots.emplace_back();
+	}
+	else
+	{
+		index = _free_entity_slots.back();
+		_free_entity_slots.pop_back();
+	}
+
+	EntitySlot& slot = _entity_slots[index];
+	slot.entity = entity;
+	return EntityHandle { index, slot.generation };
+}
+
+void Engine::_free_entity_slot( const EntityHandle handle )
+{
+	EntitySlot& slot = _entity_slots[handle.index];
+	slot.entity = nullptr;
+	slot.dense_index = INDEX_NONE;
+	slot.is_pending = false;
+
+	//  Invalidate existing handles
+	slot.generation++;
+	if ( slot.generation == 0 )
+	{
+		slot.generation = 1;
+	}
+
+	_free_entity_slots.push_back( handle.index );
+}
+
+void Engine::_activate_pending_entities()
+{
+	_entities.reserve( _entities.size() + _pending_entities.size() );
+
+	for ( SharedPtr<Entity>& entity : _pending_entities )
+	{
+		EntitySlot& slot = _entity_slots[entity->get_handle().index];
+		slot.is_pending = false;
+		slot.dense_index = static_cast<int>( _entities.size() );
+		_entities.push_back( entity );
+		_add_entity_to_tick_lists( entity.get() );
+
+		on_entity_added.invoke( entity );
+	}
+	_pending_entities.clear();
+}
+
+void Engine::_flush_command_buffers( EntityCommandBuffer* buffers, const int buffers_count )
+{
+	int commands_count = 0;
+	for ( int i = 0; i < buffers_count; i++ )
+	{
+		commands_count += buffers[i].get_commands_count();
+	}
+	if ( commands_count == 0 ) return;
+
+	PROFILE_SCOPE( "Engine::flush_command_buffers" );
+
+	using CommandType = EntityCommandBuffer::CommandType;
+	using Command = EntityCommandBuffer::Command;
+
+	FrameVector<Command> created_entities( _frame_arena.get() );
+	FrameVector<Command> deferred_kills( _frame_arena.get() );
+	FrameVector<Command> removed_components( _frame_arena.get() );
+
+	//  Apply commands in their recorded order, only batching consecutive
+	//  component removals to erase them in a single pass per entity
+	for ( int i = 0; i < buffers_count; i++ )
+	{
+		for ( const Command& command : buffers[i]._commands )
+		{
+			if ( command.type == CommandType::RemoveComponent )
+			{
+				removed_components.push_back( command );
+				continue;
+			}
+
+			if ( !removed_components.empty() )
+			{
+				_remove_components( removed_components );
+				removed_components.clear();
+			}
+
+			switch ( command.type )
+			{
+				//  Setup created entities once all commands are applied, 
+				//  so the components queued for them are there before
+				case CommandType::CreateEntity:
+				case CommandType::AddEntity:
+					created_entities.push_back( command );
+					break;
+				case CommandType::KillEntity:
+				{
+					//  Wait for the addition of entities created by this flush
+					if ( command.entity != nullptr && !is_entity_valid( command.entity->get_handle() ) )
+					{
+						deferred_kills.push_back( command );
+						break;
+					}
+
+					_kill_entity( command.handle );
+					break;
+				}
+				case CommandType::AddComponent:
+					command.entity->add_component( command.component );
+					break;
+				//  Batched above
+				case CommandType::RemoveComponent:
+					break;
+			}
+		}
+	}
+
+	if ( !removed_components.empty() )
+	{
+		_remove_components( removed_components );
+	}
+
+	//  Add entities
+	if ( !created_entities.empty() )
+	{
+		std::vector<SharedPtr<Entity>>& entities = _is_updating ? _pending_entities : _entities;
+		entities.reserve( entities.size() + created_entities.size() );
+
+		for ( const Command& command : created_entities )
+		{
+			if ( command.type == CommandType::CreateEntity )
+			{
+				command.entity->setup();
+			}
+
+			add_entity( command.entity );
+		}
+	}
+
+	//  Kill entities added by this flush
+	for ( const Command& command : deferred_kills )
+	{
+		_kill_entity( command.entity->get_handle() );
+	}
+
+	for ( int i = 0; i < buffers_count; i++ )
+	{
+		buffers[i].clear();
+	}
+}
+
+void Engine::_remove_components( FrameVector<EntityCommandBuffer::Command>& commands )
+{
+	using Command = EntityCommandBuffer::Command;
+
+	//  Group by entity to erase their components in a single pass
+	const auto is_less = []( const Command& a, const Command& b )
+	{
+		if ( a.entity != b.entity ) return a.entity < b.entity;
+		return a.component < b.component;
+	};
+	std::sort( commands.begin(), commands.end(), is_less );
+
+	auto begin = commands.begin();
+	while ( begin != commands.end() )
+	{
+		const auto end = std::find_if( begin, commands.end(),
+			[&]( const Command& command )
+			{
+				return command.entity != begin->entity;
+			}
+		);
+
+		const auto is_removed = [&]( const SharedPtr<Component>& component )
+		{
+			Command key {};
+			key.entity = begin->entity;
+			key.component = component;
+			return std::binary_search( begin, end, key, is_less );
+		};
+
+		begin->entity->_remove_components_if( is_removed );
+
+		begin = end;
+	}
+}
+
+void Engine::_kill_entity( const EntityHandle handle )
+{
+	if ( !is_entity_valid( handle ) ) return;
+
+	const EntitySlot& slot = _entity_slots[handle.index];
+	if ( slot.entity->state == EntityState::Invalid ) return;
+	slot.entity->state = EntityState::Invalid;
+
+	//  Queue active entities for this frame erase
+	if ( !slot.is_pending )
+	{
+		_dead_entities.push_back( _entities[slot.dense_index] );
+	}
+}
+
+void Engine::_store_previous_transforms()
+{
+	PROFILE_SCOPE( "Engine::store_previous_transforms" );
+
+	for ( const SharedPtr<Entity>& entity : _entities )
+	{
+		if ( entity->transform == nullptr ) continue;
+
+		entity->transform->store_previous_state();
+	}
+}
+
+void Engine::_update_tick_lists( const float dt )
+{
+	_is_updating_tick_lists = true;
+
+	for ( const int list_index : _tick_lists_order )
+	{
+		TickList& list = _tick_lists[list_index];
+
+		//  NOTE: Components are only ever tombstoned during the update, 
+		//  so iterating by index is safe.
+		for ( size_t i = 0; i < list.components.size(); i++ )
+		{
+			Component* component = list.components[i];
+			if ( component == nullptr || !component->is_active ) continue;
+			if ( list.owners[i]->state != EntityState::Active ) continue;
+
+			if ( list.is_parallel )
+			{
+				_component_scheduler.add( component );
+				continue;
+			}
+
+			component->update( dt );
+		}
+	}
+
+	_is_updating_tick_lists = false;
+	_apply_pending_ticks();
+}
+
+void Engine::_add_to_tick_lists( Entity* owner, Component* component )
+{
+	if ( component->_tick_index != INDEX_NONE ) return;
+
+	//  Only components of active entities are updated
+	const EntityHandle handle = owner->get_handle();
+	if ( !is_entity_valid( handle ) || _entity_slots[handle.index].is_pending ) return;
+
+	//  Wait for the end of the update
+	if ( _is_updating_tick_lists )
+	{
+		component->_tick_index = static_cast<int>( _pending_tick_components.size() );
+		_pending_tick_components.push_back( component );
+		_pending_tick_owners.push_back( owner );
+		return;
+	}
+
+	//  Find the list matching type and priority order
+	const ComponentTypeId type_id = component->get_type_id();
+	const int priority_order = component->get_priority_order();
+
+	int list_index = INDEX_NONE;
+	for ( const int index : _tick_lists_order )
+	{
+		const TickList& list = _tick_lists[index];
+		if ( list.type_id != type_id || list.priority_order != priority_order ) continue;
+
+		list_index = index;
+		break;
+	}
+
+	//  Create the list and keep lists sorted by descending priority order
+	if ( list_index == INDEX_NONE )
+	{
+		list_index = static_cast<int>( _tick_lists.size() );
+
+		TickList& list = _tick_lists.emplace_back();
+		list.type_id = type_id;
+		list.priority_order = priority_order;
+		list.is_parallel = component->get_update_access() != nullptr;
+
+		const auto itr = std::upper_bound( _tick_lists_order.begin(), _tick_lists_order.end(), priority_order,
+			[&]( const int order, const int index )
+			{
+				return order > _tick_lists[index].priority_order;
+			}
+		);
+		_tick_lists_order.insert( itr, list_index );
+	}
+
+	TickList& list = _tick_lists[list_index];
+	component->_tick_list_index = list_index;
+	component->_tick_index = static_cast<int>( list.components.size() );
+	list.components.push_back( component );
+	list.owners.push_back( owner );
+}
+
+void Engine::_add_entity_to_tick_lists( Entity* entity )
+{
+	for ( const SharedPtr<Component>& component : entity->components )
+	{
+		if ( !component->is_ticking() ) continue;
+		_add_to_tick_lists( entity, component.get() );
+	}
+}
+
+void Engine::_remove_from_tick_lists( Component* component )
+{
+	const int tick_index = component->_tick_index;
+	if ( tick_index == INDEX_NONE ) return;
+
+	const int list_index = component->_tick_list_index;
+	component->_tick_list_index = INDEX_NONE;
+	component->_tick_index = INDEX_NONE;
+
+	//  Remove from pending components
+	if ( list_index == INDEX_NONE )
+	{
+		if ( tick_index != static_cast<int>( _pending_tick_components.size() ) - 1 )
+		{
+			_pending_tick_components[tick_index] = _pending_tick_components.back();
+			_pending_tick_owners[tick_index] = _pending_tick_owners.back();
+			_pending_tick_components[tick_index]->_tick_index = tick_index;
+		}
+		_pending_tick_components.pop_back();
+		_pending_tick_owners.pop_back();
+		return;
+	}
+
+	TickList& list = _tick_lists[list_index];
+
+	//  Leave a hole while updating, compacted afterwards
+	if ( _is_updating_tick_lists )
+	{
+		list.components[tick_index] = nullptr;
+		list.has_holes = true;
+		return;
+	}
+
+	//  Swap with the last component to remove in constant time
+	if ( tick_index != static_cast<int>( list.components.size() ) - 1 )
+	{
+		list.components[tick_index] = list.components.back();
+		list.owners[tick_index] = list.owners.back();
+		list.components[tick_index]->_tick_index = tick_index;
+	}
+	list.components.pop_back();
+	list.owners.pop_back();
+}
+
+void Engine::_remove_entity_from_tick_lists( Entity* entity )
+{
+	for ( const SharedPtr<Component>& component : entity->components )
+	{
+		_remove_from_tick_lists( component.get() );
+	}
+}
+
+void Engine::_apply_pending_ticks()
+{
+	//  Compact lists with removed components
+	for ( TickList& list : _tick_lists )
+	{
+		if ( !list.has_holes ) continue;
+
+		size_t new_size = 0;
+		for ( size_t i = 0; i < list.components.size(); i++ )
+		{
+			Component* component = list.components[i];
+			if ( component == nullptr ) continue;
+
+			component->_tick_index = static_cast<int>( new_size );
+			list.components[new_size] = component;
+			list.owners[new_size] = list.owners[i];
+			new_size++;
+		}
+
+		list.components.resize( new_size );
+		list.owners.resize( new_size );
+		list.has_holes = false;
+	}
+
+	//  Add pending components
+	for ( size_t i = 0; i < _pending_tick_components.size(); i++ )
+	{
+		Component* component = _pending_tick_components[i];
+		component->_tick_index = INDEX_NONE;
+		_add_to_tick_lists( _pending_tick_owners[i], component );
+	}
+	_pending_tick_components.clear();
+	_pending_tick_owners.clear();
+}
+
+void Engine::_clear_tick_lists()
+{
+	//  Forget about the components as their entities are released
+	for ( TickList& list : _tick_lists )
+	{
+		for ( Component* component : list.components )
+		{
+			if ( component == nullptr ) continue;
+
+			component->_tick_list_index = INDEX_NONE;
+			component->_tick_index = INDEX_NONE;
+		}
+
+		list.components.clear();
+		list.owners.clear();
+		list.has_holes = false;
+	}
+
+	for ( Component* component : _pending_tick_components )
+	{
+		component->_tick_index = INDEX_NONE;
+	}
+	_pending_tick_components.clear();
+	_pending_tick_owners.clear();
+}
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <suprengine/core/component-registry.h>
+#include <suprengine/core/component-scheduler.h>
+#include <suprengine/core/entity-command-buffer.h>
+#include <suprengine/core/entity-handle.h>
 #include <suprengine/core/game.h>
+#include <suprengine/core/job-system.h>
 #include <suprengine/core/physics.h>
 #include <suprengine/core/scene.h>
+#include <suprengine/core/timer-wheel.h>
 #include <suprengine/core/updater.h>
 #include <suprengine/input/input-manager.h>
 
 #include <suprengine/components/camera.h>
 
 #include <suprengine/utils/assert.h>
-#include <suprengine/utils/timer.h>
+#include <suprengine/utils/frame-arena.h>
 
+#include <suprengine/tools/benchmark-report.h>
 #include <suprengine/tools/memory-profiler.h>
 #include <suprengine/tools/profiler.h>
 
@@ -18,6 +25,42 @@
 
 namespace suprengine
 {
+	/*
+	 * Options given to the engine on initialization.
+	 */
+	struct EngineInfos
+	{
+		/*
+		 * Run without window, graphics backend nor ImGui, rendering through
+		 * a NullRenderBatch in place of the game's render batch.
+		 * Frame rate is uncapped.
+		 */
+		bool is_headless = false;
+
+		/*
+		 * Amount of frames to run before quitting and writing a benchmark 
+		 * report, or 0 to run until quitting.
+		 * Benchmarked frames update with 'benchmark_delta_time', without
+		 * frame cap nor vertical synchronization.
+		 */
+		int benchmark_frames_count = 0;
+		float benchmark_delta_time = 1.0f / 60.0f;
+		std::string benchmark_report_path = "benchmark-report.json";
+
+		/*
+		 * Amount of first frames to capture into a Chrome trace file, 
+		 * or 0 to not trace.
+		 */
+		int trace_frames_count = 0;
+		std::string trace_path = "profile-trace.json";
+
+		/*
+		 * Capacity in bytes of the frame arena, exceeding allocations
+		 * falling back to the heap.
+		 */
+		std::size_t frame_arena_capacity = 1024 * 1024;
+	};
+
 	class Engine
 	{
 	public:
@@ -40,24 +83,24 @@ namespace suprengine
 		 * Create and run the game of given type on the engine.
 		 */
 		template <typename GameType>
-		std::enable_if_t<std::is_base_of_v<IGame, GameType>, int> run()
+		std::enable_if_t<std::is_base_of_v<IGame, GameType>, int> run( const EngineInfos& infos = {} )
 		{
-			if ( !init<GameType>() ) return EXIT_FAILURE;
+			if ( !init<GameType>( infos ) ) return EXIT_FAILURE;
 
 			loop();
 			return EXIT_SUCCESS;
 		}
 
 		template <typename GameType>
-		std::enable_if_t<std::is_base_of_v<IGame, GameType>, bool> init()
+		std::enable_if_t<std::is_base_of_v<IGame, GameType>, bool> init( const EngineInfos& infos = {} )
 		{
 			MEMORY_SCOPE( "Engine::init" );
 
 			//  Create game
 			auto game = new GameType();
-			return init( game );
+			return init( game, infos );
 		}
-		bool init( IGame* game );
+		bool init( IGame* game, const EngineInfos& infos = {} );
 		void loop();
 
 		template <typename TScene, typename ...TArgs>
@@ -78,38 +121,129 @@ namespace suprengine
 		}
 		Scene* get_scene() const { return _scene.get(); }
 
+		/*
+		 * Create, setup and add an entity of given type to the engine.
+		 * The entity and its reference counter share a single pooled 
+		 * allocation.
+		 * The entity is issued an EntityHandle, accessible through
+		 * Entity::get_handle.
+		 * During the parallel update of components, the entity is created
+		 * through the worker's command buffer, deferring both setup and
+		 * addition to the end of it.
+		 */
 		template <typename TEntity, typename ...TArgs>
 		std::enable_if_t<
 			std::is_base_of_v<Entity, TEntity> && std::is_constructible_v<TEntity, TArgs...>,
 			SharedPtr<TEntity>
 		> create_entity( TArgs&& ...args )
 		{
-			SharedPtr<TEntity> entity( new TEntity( args... ) );
+			//  Defer setup as it may register components into engine systems
+			if ( _is_updating_in_parallel )
+			{
+				return get_command_buffer()->create_entity<TEntity>( args... );
+			}
+
+			SharedPtr<TEntity> entity = std::allocate_shared<TEntity>(
+				PoolStlAllocator<TEntity>( "Entity" ), args... );
 			entity->init();
 			entity->setup();
 			add_entity( entity );
 
 			return entity;
 		}
+		/*
+		 * Add an entity to the engine and issue its handle.
+		 * Adding an already added entity results in no operation.
+		 * During the parallel update of components, the addition is
+		 * recorded into the worker's command buffer.
+		 */
 		void add_entity( const SharedPtr<Entity>& entity );
+		/*
+		 * Remove an entity from the engine, invalidating its handle.
+		 */
 		void remove_entity( const SharedPtr<Entity>& entity );
 		void clear_entities();
 
-		void add_timer( const Timer& timer );
+		/*
+		 * Returns whenever the handle refers to an entity currently 
+		 * added to the engine, either active or pending.
+		 */
+		bool is_entity_valid( EntityHandle handle ) const;
+		/*
+		 * Returns the entity referred by the handle, or nullptr if 
+		 * the handle is invalid.
+		 */
+		Entity* get_entity( EntityHandle handle ) const;
+		int get_entities_count() const;
+		/*
+		 * Returns the amount of components updated by the engine, which
+		 * only includes active entities components overriding update.
+		 */
+		int get_ticking_components_count() const;
+
+		/*
+		 * Returns whenever components are being updated in parallel.
+		 * Structural changes such as adding or killing entities are
+		 * recorded into command buffers during this phase.
+		 */
+		bool is_updating_in_parallel() const { return _is_updating_in_parallel; }
+		/*
+		 * Returns the command buffer of the calling job system worker.
+		 * Recorded commands are applied at the next sync point of the
+		 * engine update: at its start and after the parallel update
+		 * of components.
+		 */
+		EntityCommandBuffer* get_command_buffer();
+		/*
+		 * Apply and clear the commands of the buffer.
+		 */
+		void flush_command_buffer( EntityCommandBuffer* buffer );
+
+		/*
+		 * Add a timer, updated at each engine update.
+		 * The returned handle allows to cancel, pause or reschedule it.
+		 */
+		TimerHandle add_timer( const Timer& timer );
+		TimerWheel* get_timers();
 
 		void add_camera(SharedPtr<Camera> camera);
 		void remove_camera(SharedPtr<Camera> camera);
 		SharedPtr<Camera> get_camera( int camera_id ) const;
 
 		bool is_running() const;
+		/*
+		 * Request the engine to stop running at the end of the current frame.
+		 */
+		void quit();
+		/*
+		 * Returns whenever the engine runs without window, graphics
+		 * backend nor ImGui.
+		 */
+		bool is_headless() const { return _is_headless; }
+		/*
+		 * Returns the report of the benchmark run, or nullptr when not
+		 * running a benchmark.
+		 */
+		const BenchmarkReport* get_benchmark_report() const { return _benchmark_report.get(); }
 
 		IGame* get_game() const { return _game.get(); }
 		Window* get_window() const { return _window.get(); }
 		RenderBatch* get_render_batch() const { return _render_batch.get(); }
 		InputManager* get_inputs() const { return _inputs.get(); }
 		Physics* get_physics() const { return _physics.get(); }
+		JobSystem* get_jobs() const { return _jobs.get(); }
+		/*
+		 * Returns the arena for temporary allocations, reset at the
+		 * start of each frame.
+		 */
+		FrameArena* get_frame_arena() const { return _frame_arena.get(); }
 		Updater* get_updater() { return &_updater; }
 		Profiler* get_profiler() { return &_profiler; }
+		/*
+		 * Returns the opt-in data-oriented component storage.
+		 */
+		ComponentRegistry* get_component_registry() { return &_component_registry; }
+		ComponentScheduler* get_component_scheduler() { return &_component_scheduler; }
 
 	public:
 		/*
@@ -135,17 +269,83 @@ namespace suprengine
 	public:
 		bool is_game_paused = false;
 
+	private:
+		/*
+		 * Slot of the entities slot map, referred by EntityHandle::index.
+		 */
+		struct EntitySlot
+		{
+			Entity* entity = nullptr;
+			uint32 generation = 1;
+			/*
+			 * Index of the entity inside either the pending or active entities.
+			 */
+			int dense_index = INDEX_NONE;
+			bool is_pending = false;
+		};
+
+		/*
+		 * List of ticking components sharing both type and priority order.
+		 */
+		struct TickList
+		{
+			ComponentTypeId type_id = 0;
+			int priority_order = 0;
+			/*
+			 * Whenever the component type declares its update access, in 
+			 * which case the components are updated by the scheduler.
+			 */
+			bool is_parallel = false;
+
+			/*
+			 * Components, set to nullptr when removed during the update
+			 * and compacted after it.
+			 */
+			std::vector<Component*> components {};
+			std::vector<Entity*> owners {};
+			bool has_holes = false;
+		};
+
 	private:
 		Engine() = default;
 
 		void process_input();
+		/*
+		 * Update the scene, the components by type, the entities, then
+		 * the components declaring their access in parallel.
+		 * See Component::update for the order contract.
+		 */
 		void update( float dt );
-		void render();
+		void render( float interpolation_alpha );
+
+		EntityHandle _allocate_entity_slot( Entity* entity );
+		void _free_entity_slot( EntityHandle handle );
+		void _activate_pending_entities();
+
+		void _flush_command_buffers( EntityCommandBuffer* buffers, int buffers_count );
+		void _remove_components( FrameVector<EntityCommandBuffer::Command>& commands );
+		void _kill_entity( EntityHandle handle );
+		/*
+		 * Store the transforms state of all entities, before a fixed tick,
+		 * so renderers can interpolate from it.
+		 */
+		void _store_previous_transforms();
+
+		void _update_tick_lists( float dt );
+		void _add_to_tick_lists( Entity* owner, Component* component );
+		void _add_entity_to_tick_lists( Entity* entity );
+		void _remove_from_tick_lists( Component* component );
+		void _remove_entity_from_tick_lists( Entity* entity );
+		void _apply_pending_ticks();
+		void _clear_tick_lists();
 
 	private:
 		std::vector<SharedPtr<Entity>> _pending_entities {}, _entities {}, _dead_entities {};
 
-		std::vector<Timer> _timers {};
+		std::vector<EntitySlot> _entity_slots {};
+		std::vector<uint32> _free_entity_slots {};
+
+		TimerWheel _timers {};
 		std::vector<SharedPtr<Camera>> _cameras {};
 
 		std::unique_ptr<IGame> _game;
@@ -153,12 +353,37 @@ namespace suprengine
 		std::unique_ptr<RenderBatch> _render_batch;
 		std::unique_ptr<InputManager> _inputs;
 		std::unique_ptr<Physics> _physics;
+		std::unique_ptr<JobSystem> _jobs;
+		std::unique_ptr<FrameArena> _frame_arena;
 		std::unique_ptr<Scene> _scene;
+		std::unique_ptr<BenchmarkReport> _benchmark_report;
+		std::string _benchmark_report_path {};
+		float _benchmark_delta_time = 0.0f;
 
 		Profiler _profiler {};
 		Updater _updater {};
+		ComponentRegistry _component_registry {};
+		ComponentScheduler _component_scheduler {};
+
+		std::vector<EntityCommandBuffer> _command_buffers {};
+
+		std::vector<TickList> _tick_lists {};
+		/*
+		 * Indices of tick lists, sorted by update order.
+		 */
+		std::vector<int> _tick_lists_order {};
+		/*
+		 * Components added during the update of tick lists.
+		 */
+		std::vector<Component*> _pending_tick_components {};
+		std::vector<Entity*> _pending_tick_owners {};
+		bool _is_updating_tick_lists = false;
 
 		bool _is_running = true;
+		bool _is_headless = false;
 		bool _is_updating = false;
+		bool _is_updating_in_parallel = false;
+
+		friend class Entity;
 	};
 }
@@ -0,0 +1,43 @@
+#include "entity-command-buffer.h"
+
+using namespace suprengine;
+
+void EntityCommandBuffer::add_entity( const SharedPtr<Entity>& entity )
+{
+	_commands.push_back( Command { CommandType::AddEntity, entity } );
+}
+
+void EntityCommandBuffer::kill( const EntityHandle handle )
+{
+	_commands.push_back( Command { CommandType::KillEntity, nullptr, nullptr, handle } );
+}
+
+void EntityCommandBuffer::kill( const SharedPtr<Entity>& entity )
+{
+	_commands.push_back( Command { CommandType::KillEntity, entity, nullptr, entity->get_handle() } );
+}
+
+void EntityCommandBuffer::add_component( const SharedPtr<Entity>& entity, const SharedPtr<Component>& component )
+{
+	_commands.push_back( Command { CommandType::AddComponent, entity, component } );
+}
+
+void EntityCommandBuffer::remove_component( const SharedPtr<Entity>& entity, const SharedPtr<Component>& component )
+{
+	_commands.push_back( Command { CommandType::RemoveComponent, entity, component } );
+}
+
+bool EntityCommandBuffer::is_empty() const
+{
+	return _commands.empty();
+}
+
+int EntityCommandBuffer::get_commands_count() const
+{
+	return static_cast<int>( _commands.size() );
+}
+
+void EntityCommandBuffer::clear()
+{
+	_commands.clear();
+}
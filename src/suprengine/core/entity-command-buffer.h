@@ -0,0 +1,116 @@
+#pragma once
+
+#include <suprengine/core/entity.h>
+
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Records structural changes on entities to apply them later, in bulk,
+	 * when the engine flushes the buffer.
+	 *
+	 * Commands are applied in the order they were recorded, so removing
+	 * then adding back a component leaves it on its entity. Only created
+	 * entities are deferred to the end of the flush (see 'create_entity').
+	 *
+	 * The engine owns a buffer per job system worker, accessible through
+	 * Engine::get_command_buffer, and flushes them at its sync points.
+	 * A buffer isn't thread-safe: only one thread must record into it.
+	 */
+	class EntityCommandBuffer
+	{
+	public:
+		/*
+		 * Create and initialize an entity of given type. Its setup and
+		 * addition to the engine are deferred to the flush.
+		 * 
+		 * The returned entity has no valid handle until then, but can
+		 * already be referenced by the other commands: created entities
+		 * are setup and added at the end of the flush, so the components
+		 * added to them are there before their setup, and killing them
+		 * kills them right after their addition.
+		 */
+		template <typename TEntity, typename ...TArgs>
+		std::enable_if_t<
+			std::is_base_of_v<Entity, TEntity> && std::is_constructible_v<TEntity, TArgs...>,
+			SharedPtr<TEntity>
+		> create_entity( TArgs&& ...args )
+		{
+			SharedPtr<TEntity> entity = std::allocate_shared<TEntity>(
+				PoolStlAllocator<TEntity>( "Entity" ), args... );
+			entity->init();
+
+			_commands.push_back( Command { CommandType::CreateEntity, entity } );
+			return entity;
+		}
+		/*
+		 * Add an already setup entity to the engine.
+		 */
+		void add_entity( const SharedPtr<Entity>& entity );
+		/*
+		 * Kill the entity referred by the handle.
+		 */
+		void kill( EntityHandle handle );
+		/*
+		 * Kill the entity, which may be created by a command buffer
+		 * and so not have a valid handle yet.
+		 */
+		void kill( const SharedPtr<Entity>& entity );
+
+		/*
+		 * Create and initialize a component of given type. Its addition
+		 * to the entity, and so its setup, are deferred to the flush.
+		 */
+		template <typename TComponent, typename ...TArgs>
+		std::enable_if_t<
+			std::is_base_of_v<Component, TComponent> && std::is_constructible_v<TComponent, TArgs...>,
+			SharedPtr<TComponent>
+		> create_component( const SharedPtr<Entity>& entity, TArgs&& ...args )
+		{
+			SharedPtr<TComponent> component = std::allocate_shared<TComponent>(
+				PoolStlAllocator<TComponent>( "Component" ), args... );
+			component->init( entity );
+			component->_is_ticking = is_component_ticking_v<TComponent>;
+			component->_type_id = ComponentType::get_id<TComponent>();
+
+			add_component( entity, component );
+			return component;
+		}
+		void add_component( const SharedPtr<Entity>& entity, const SharedPtr<Component>& component );
+		void remove_component( const SharedPtr<Entity>& entity, const SharedPtr<Component>& component );
+
+		bool is_empty() const;
+		int get_commands_count() const;
+		void clear();
+
+	private:
+		enum class CommandType
+		{
+			CreateEntity,
+			AddEntity,
+			KillEntity,
+			AddComponent,
+			RemoveComponent,
+		};
+
+		struct Command
+		{
+			CommandType type = CommandType::CreateEntity;
+
+			/*
+			 * Entity of the command. For kills, it is only set to resolve
+			 * the handle during the flush, when the entity wasn't added 
+			 * to the engine yet.
+			 */
+			SharedPtr<Entity> entity = nullptr;
+			SharedPtr<Component> component = nullptr;
+			EntityHandle handle {};
+		};
+
+		friend class Engine;
+
+	private:
+		std::vector<Command> _commands {};
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <suprengine/utils/safe-ptr.h>
+#include <suprengine/utils/usings.h>
+
+namespace suprengine
+{
+	class Entity;
+
+	/*
+	 * Identifier of an entity registered in the engine, composed of
+	 * a slot index and a generation counter.
+	 * 
+	 * Once an entity is removed from the engine, the generation of its
+	 * slot is incremented, invalidating all existing handles to it even
+	 * if the slot is later re-used by another entity.
+	 * 
+	 * A default-constructed handle is always invalid.
+	 */
+	struct EntityHandle
+	{
+	public:
+		uint32 index = 0;
+		/*
+		 * Generation of the slot when the handle has been issued.
+		 * Generations start at 1, so 0 is reserved to null handles.
+		 */
+		uint32 generation = 0;
+
+	public:
+		bool is_null() const { return generation == 0; }
+
+		bool operator==( const EntityHandle& other ) const
+		{
+			return index == other.index && generation == other.generation;
+		}
+		bool operator!=( const EntityHandle& other ) const
+		{
+			return !( *this == other );
+		}
+	};
+
+	/*
+	 * Specialization of SafePtr for entities, keeping the entity's
+	 * handle on top of a weak pointer. See SafePtr for its semantics.
+	 */
+	template <>
+	class SafePtr<Entity>
+	{
+	public:
+		SafePtr() = default;
+		SafePtr( nullptr_t ) {}
+		SafePtr( EntityHandle handle ) : _handle( handle ) {}
+		SafePtr( const std::shared_ptr<Entity>& ptr );
+		SafePtr( const std::weak_ptr<Entity>& ptr ) : SafePtr( ptr.lock() ) {}
+		template <typename TEntity>
+		SafePtr( const std::shared_ptr<TEntity>& ptr ) 
+			: SafePtr( std::static_pointer_cast<Entity>( ptr ) ) {}
+
+		/*
+		 * Returns whenever the entity is alive and hasn't been removed
+		 * from the engine.
+		 */
+		[[nodiscard]] bool is_valid() const;
+		/*
+		 * Returns the raw pointer to the entity, or nullptr if invalid.
+		 */
+		[[nodiscard]] Entity* get() const;
+		/*
+		 * Returns the handle of the entity, which is null until the
+		 * entity is added to the engine.
+		 */
+		[[nodiscard]] EntityHandle get_handle() const;
+
+		[[nodiscard]] Entity* operator->() const
+		{
+			return get();
+		}
+		[[nodiscard]] bool operator==( const SafePtr<Entity>& ptr ) const
+		{
+			return get() == ptr.get();
+		}
+
+		explicit operator bool() const
+		{
+			return is_valid();
+		}
+
+	private:
+		std::weak_ptr<Entity> _entity {};
+		/*
+		 * Handle of the entity if it was already added to the engine on
+		 * construction, otherwise it is looked up from the entity on access.
+		 */
+		EntityHandle _handle {};
+	};
+}
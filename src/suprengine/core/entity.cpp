@@ -1,5 +1,8 @@
 #include "entity.h"
 
+#include <suprengine/core/component-scheduler.h>
+#include <suprengine/core/engine.h>
+
 using namespace suprengine;
 
 int Entity::_global_id { 0 };
@@ -12,15 +15,27 @@ Entity::Entity()
 Entity::~Entity()
 {
 	//  Release components
+	//  NOTE: Components are directly removed since a command buffer can't 
+	//  refer to an entity being destroyed.
 	while ( !components.empty() )
 	{
-		auto& component = components.back();
-		remove_component( component );
+		components.back()->unsetup();
+		_remove_from_tick_lists( components.back().get() );
+		components.pop_back();
+		_component_entries.pop_back();
 	}
 }
 
 void Entity::add_component( const SharedPtr<Component>& component )
 {
+	//  Defer as the component setup may register it into engine systems
+	Engine& engine = Engine::instance();
+	if ( engine.is_updating_in_parallel() )
+	{
+		engine.get_command_buffer()->add_component( shared_from_this(), component );
+		return;
+	}
+
 	if ( std::find( components.begin(), components.end(), component ) != components.end() ) return;
 
 	//  Get update order
@@ -36,21 +51,47 @@ void Entity::add_component( const SharedPtr<Component>& component )
 		}
 	}
 
-	//  Insert into vector
+	//  Cache the type of components not created from their static type
+	if ( component->_type_id == ComponentType::INVALID_ID )
+	{
+		component->_type_id = ComponentType::get_id( typeid( *component ) );
+	}
+
+	//  Insert into vectors
+	_component_entries.insert(
+		_component_entries.begin() + ( itr - components.begin() ),
+		ComponentEntry { component->_type_id, component.get() }
+	);
 	components.insert( itr, component );
+	_rebuild_components_index();
 
 	component->setup();
+
+	if ( component->is_ticking() )
+	{
+		engine._add_to_tick_lists( this, component.get() );
+	}
 }
 
 void Entity::remove_component( const SharedPtr<Component>& component )
 {
+	Engine& engine = Engine::instance();
+	if ( engine.is_updating_in_parallel() )
+	{
+		engine.get_command_buffer()->remove_component( shared_from_this(), component );
+		return;
+	}
+
 	const auto itr = std::find( components.begin(), components.end(), component );
 	if ( itr == components.end() ) return;
 
 	component->unsetup();
+	_remove_from_tick_lists( component.get() );
 
-	//  Erase component from vector
+	//  Erase component from vectors
+	_component_entries.erase( _component_entries.begin() + ( itr - components.begin() ) );
 	components.erase( itr );
+	_rebuild_components_index();
 }
 
 void Entity::init()
@@ -59,19 +100,118 @@ void Entity::init()
 	transform = create_component<Transform>();
 }
 
-void Entity::update( const float dt )
+void Entity::update( const float dt, ComponentScheduler* scheduler )
 {
 	//  Update components first
 	for ( const SharedPtr<Component>& component : components )
 	{
-		if ( !component->is_active ) continue;
+		if ( !component->is_active || !component->is_ticking() ) continue;
+
+		//  Let the scheduler update components declaring their access
+		if ( scheduler != nullptr && component->get_update_access() != nullptr )
+		{
+			scheduler->add( component.get() );
+			continue;
+		}
+
 		component->update( dt );
 	}
 
 	update_this( dt );
 }
 
+void Entity::_rebuild_components_index()
+{
+	_components_index.clear();
+	_indexed_types_count = ComponentType::get_resolvable_types_count();
+	_has_unresolvable_components = false;
+
+	//  Index components of exact types first, so they are preferred
+	for ( const ComponentEntry& entry : _component_entries )
+	{
+		if ( entry.type_id >= _indexed_types_count )
+		{
+			_has_unresolvable_components = true;
+			return;
+		}
+
+		_components_index.try_emplace( entry.type_id, entry.component );
+	}
+
+	//  Then index them by their base types
+	for ( const ComponentEntry& entry : _component_entries )
+	{
+		for ( ComponentTypeId base_id = 0; base_id < _indexed_types_count; base_id++ )
+		{
+			if ( !ComponentType::is_derived_from( entry.type_id, base_id ) ) continue;
+
+			_components_index.try_emplace( base_id, entry.component );
+		}
+	}
+}
+
+void Entity::_remove_from_tick_lists( Component* component )
+{
+	//  Avoid accessing the engine for components it doesn't know about
+	if ( component->_tick_index == INDEX_NONE ) return;
+
+	Engine::instance()._remove_from_tick_lists( component );
+}
+
 void Entity::kill()
 {
+	Engine& engine = Engine::instance();
+	if ( engine.is_updating_in_parallel() )
+	{
+		//  Reference a deferred entity by itself as it has no handle yet
+		if ( engine.is_entity_valid( _handle ) )
+		{
+			engine.get_command_buffer()->kill( _handle );
+		}
+		else
+		{
+			engine.get_command_buffer()->kill( shared_from_this() );
+		}
+		return;
+	}
+
 	state = EntityState::Invalid;
 }
+
+
+SafePtr<Entity>::SafePtr( const std::shared_ptr<Entity>& ptr )
+	: _entity( ptr )
+{
+	if ( ptr == nullptr ) return;
+
+	_handle = ptr->get_handle();
+}
+
+bool SafePtr<Entity>::is_valid() const
+{
+	return get() != nullptr;
+}
+
+Entity* SafePtr<Entity>::get() const
+{
+	if ( !_handle.is_null() ) return Engine::instance().get_entity( _handle );
+
+	//  Look the handle up, as the entity may have been added since
+	const SharedPtr<Entity> entity = _entity.lock();
+	if ( entity == nullptr ) return nullptr;
+
+	const EntityHandle handle = entity->get_handle();
+	if ( handle.is_null() ) return entity.get();
+
+	return Engine::instance().get_entity( handle );
+}
+
+EntityHandle SafePtr<Entity>::get_handle() const
+{
+	if ( !_handle.is_null() ) return _handle;
+
+	const SharedPtr<Entity> entity = _entity.lock();
+	if ( entity == nullptr ) return EntityHandle {};
+
+	return entity->get_handle();
+}
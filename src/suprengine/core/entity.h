@@ -1,7 +1,12 @@
 #pragma once
 
+#include <suprengine/core/component-type.h>
+#include <suprengine/core/entity-handle.h>
+
 #include <suprengine/components/transform.h>
 
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/pool-allocator.h>
 #include <suprengine/utils/shareable.h>
 
 #include <suprengine/tools/memory-profiler.h>
@@ -10,6 +15,8 @@
 
 namespace suprengine
 {
+	class ComponentScheduler;
+
 	enum class EntityState
 	{
 		Active,
@@ -28,6 +35,8 @@ namespace suprengine
 		/*
 		 * Create and add a component of given type on the entity.
 		 * This is the function you want to use inside Entity::setup.
+		 * The component and its reference counter share a single pooled 
+		 * allocation.
 		 */
 		template <typename TComponent, typename ...TArgs>
 		std::enable_if_t<
@@ -35,34 +44,107 @@ namespace suprengine
 			SharedPtr<TComponent>
 		> create_component( TArgs&& ...args )
 		{
-			SharedPtr<TComponent> component( new TComponent( args... ) );
+			SharedPtr<TComponent> component = std::allocate_shared<TComponent>(
+				PoolStlAllocator<TComponent>( "Component" ), args... );
 			component->init( shared_from_this() );
+			component->_is_ticking = is_component_ticking_v<TComponent>;
+			component->_type_id = ComponentType::get_id<TComponent>();
 			add_component( component );
 			
 			return component;
 		}
+		/*
+		 * Add a component to the entity and setup it.
+		 * During the parallel update of components, the addition is
+		 * recorded into the worker's command buffer.
+		 */
 		void add_component( const SharedPtr<Component>& component );
+		/*
+		 * Unsetup and remove a component from the entity.
+		 * During the parallel update of components, the removal is
+		 * recorded into the worker's command buffer.
+		 */
 		void remove_component( const SharedPtr<Component>& component);
 		/*
-		 * Find for a component matching the given type from the
-		 * vector of components of the entity.
+		 * Find for a component matching the given type, or nullptr if
+		 * none is found.
+		 * Components of the exact type are preferred over the ones of
+		 * derived types. Both are looked up in constant time inside an
+		 * index of the components by type identifier, which also holds
+		 * the base types of each component. Types registered after the
+		 * last change of the index are looked for by a scan of the 
+		 * components, until the engine refreshes the index on its next 
+		 * update.
 		 */
 		template <typename T>
 		std::enable_if_t<
 			std::is_base_of_v<Component, T>,
-			SharedPtr<T>
-		> find_component()
+			T*
+		> find_component() const
 		{
-			for ( SharedPtr<Component> component : components )
+			const ComponentTypeId type_id = ComponentType::get_id<T>();
+			if ( !_has_unresolvable_components && type_id < _indexed_types_count )
+			{
+				const auto itr = _components_index.find( type_id );
+				if ( itr == _components_index.end() ) return nullptr;
+
+				return static_cast<T*>( itr->second );
+			}
+
+			for ( const ComponentEntry& entry : _component_entries )
+			{
+				if ( entry.type_id != type_id ) continue;
+				return static_cast<T*>( entry.component );
+			}
+
+			if constexpr ( !std::is_final_v<T> )
 			{
-				SharedPtr<T> target = std::dynamic_pointer_cast<T>( component );
-				if ( !target ) continue;
+				for ( const ComponentEntry& entry : _component_entries )
+				{
+					if ( !ComponentType::is_derived_from<T>( entry.type_id, entry.component ) ) continue;
 
-				return target;
+					return static_cast<T*>( entry.component );
+				}
 			}
 
 			return nullptr;
 		}
+		/*
+		 * Find all components matching the given type, appending them to
+		 * the given vector. Contrary to Entity::find_component, it always
+		 * scans the components, through the cached relationships of their
+		 * type identifiers (see ComponentType::is_derived_from).
+		 */
+		template <typename T>
+		std::enable_if_t<
+			std::is_base_of_v<Component, T>
+		> find_components( std::vector<T*>* out_components ) const
+		{
+			const ComponentTypeId type_id = ComponentType::get_id<T>();
+			for ( const ComponentEntry& entry : _component_entries )
+			{
+				if ( entry.type_id == type_id )
+				{
+					out_components->push_back( static_cast<T*>( entry.component ) );
+					continue;
+				}
+
+				if constexpr ( !std::is_final_v<T> )
+				{
+					if ( !ComponentType::is_derived_from<T>( entry.type_id, entry.component ) ) continue;
+
+					out_components->push_back( static_cast<T*>( entry.component ) );
+				}
+			}
+		}
+		template <typename T>
+		std::enable_if_t<
+			std::is_base_of_v<Component, T>,
+			bool
+		> has_component() const
+		{
+			return find_component<T>() != nullptr;
+		}
 
 		/*
 		 * Initialize the entity with default components such as a
@@ -70,13 +152,19 @@ namespace suprengine
 		 */
 		void init();
 		/*
-		 * Update both the entity components and itself for a frame.
+		 * Update both the entity ticking components and itself for a frame.
+		 * The engine doesn't use this function, as it updates components
+		 * by type through its tick lists.
+		 * If a scheduler is given, components declaring their update
+		 * access are queued into it instead of being updated.
 		 */
-		void update( float dt );
+		void update( float dt, ComponentScheduler* scheduler = nullptr );
 		/*
 		 * Set entity's state to EntityState::Invalid. 
 		 * Depending on update order, the entity will be deleted
 		 * at the end of, either, the current frame or the next one.
+		 * During the parallel update of components, the kill is recorded
+		 * into the worker's command buffer.
 		 */
 		void kill();
 
@@ -87,7 +175,9 @@ namespace suprengine
 		 */
 		virtual void setup() {};
 		/*
-		 * Called when the entity is updated for this frame.
+		 * Called when the entity is updated for this frame, after the
+		 * sequential update of the components of all entities (see
+		 * Component::update for the full order).
 		 * You can put your own logic here.
 		 */
 		virtual void update_this( float dt ) {}
@@ -101,14 +191,21 @@ namespace suprengine
 		 * Get the entity's unique identifier.
 		 */
 		int get_unique_id() const { return _unique_id; }
+		/*
+		 * Get the handle issued by the engine when the entity has been
+		 * added to it. Null if the entity has never been added.
+		 */
+		EntityHandle get_handle() const { return _handle; }
 
 	public:
-	#ifdef ENABLE_MEMORY_PROFILER
 		static void* operator new( std::size_t bytes )
 		{
-			return MemoryProfiler::allocate( "Entity", bytes );
+			return PoolAllocator::allocate( "Entity", bytes );
+		}
+		static void operator delete( void* pointer, std::size_t bytes )
+		{
+			PoolAllocator::deallocate( "Entity", pointer, bytes );
 		}
-	#endif
 
 	public:
 		/*
@@ -123,7 +220,9 @@ namespace suprengine
 		EntityState state { EntityState::Active };
 
 		/*
-		 * Vector of all entity components
+		 * Vector of all entity components.
+		 * Use Entity::add_component and Entity::remove_component to
+		 * modify it.
 		 */
 		std::vector<SharedPtr<Component>> components;
 
@@ -133,9 +232,88 @@ namespace suprengine
 		 */
 		SharedPtr<Transform> transform;
 
+	private:
+		/*
+		 * Small map from component types to components, in the same
+		 * order as the components vector.
+		 */
+		struct ComponentEntry
+		{
+			ComponentTypeId type_id = 0;
+			Component* component = nullptr;
+		};
+
+	private:
+		/*
+		 * Unsetup and remove all components matching the predicate,
+		 * in a single pass.
+		 */
+		template <typename TPredicate>
+		void _remove_components_if( TPredicate&& predicate )
+		{
+			size_t new_size = 0;
+			for ( size_t i = 0; i < components.size(); i++ )
+			{
+				if ( predicate( components[i] ) )
+				{
+					components[i]->unsetup();
+					_remove_from_tick_lists( components[i].get() );
+					continue;
+				}
+
+				if ( i != new_size )
+				{
+					components[new_size] = std::move( components[i] );
+					_component_entries[new_size] = _component_entries[i];
+				}
+				new_size++;
+			}
+
+			components.resize( new_size );
+			_component_entries.resize( new_size );
+			_rebuild_components_index();
+		}
+
+		void _remove_from_tick_lists( Component* component );
+
+		/*
+		 * Rebuild the index of the components by type identifier, from
+		 * the components entries.
+		 */
+		void _rebuild_components_index();
+		/*
+		 * Rebuild the index if types have been registered since its last
+		 * rebuild. Must not be called during the parallel update.
+		 */
+		void _refresh_components_index()
+		{
+			if ( _indexed_types_count == ComponentType::get_resolvable_types_count() ) return;
+			_rebuild_components_index();
+		}
+
 	private:
 		int _unique_id = -1;
 		static int _global_id;
+
+		EntityHandle _handle {};
+
+		std::vector<ComponentEntry> _component_entries {};
+
+		/*
+		 * First component, in update order, of each type identifier, whether
+		 * it is of that type or derives from it. Only holds the types whose
+		 * identifier is below the indexed types count.
+		 */
+		FlatHashMap<ComponentTypeId, Component*> _components_index {};
+		ComponentTypeId _indexed_types_count = 0;
+		/*
+		 * Whenever a component type hasn't been registered with the template
+		 * ComponentType::get_id, so the index can't be built and components
+		 * are always scanned.
+		 */
+		bool _has_unresolvable_components = false;
+
+		friend class Engine;
 	};
 }
 
@@ -25,6 +25,11 @@ namespace suprengine
 		virtual void release() = 0;
 
 		virtual RenderBatch* create_render_batch( Window* window ) = 0;
+		/*
+		 * Set the render batch created by the engine in place of the
+		 * game's one, such as when running headless.
+		 */
+		virtual void set_render_batch( RenderBatch* render_batch ) = 0;
 
 		virtual GameInfos get_infos() const = 0;
 
@@ -49,13 +54,18 @@ namespace suprengine
 			return _render_batch;
 		}
 
+		void set_render_batch( RenderBatch* render_batch ) override { _render_batch = render_batch; }
 		void set_engine( Engine* engine ) override { _engine = engine; };
 
 		Engine* get_engine() const override { return _engine; }
-		TRenderBatch* get_render_batch() const { return _render_batch; }
+		/*
+		 * Returns the render batch, which is only of type TRenderBatch
+		 * when the engine isn't headless.
+		 */
+		RenderBatch* get_render_batch() const { return _render_batch; }
 		
 	private:
-		TRenderBatch* _render_batch { nullptr };
+		RenderBatch* _render_batch { nullptr };
 		Engine* _engine { nullptr };
 
 		friend class Engine;
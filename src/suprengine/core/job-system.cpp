@@ -0,0 +1,381 @@
+#include "job-system.h"
+
+#include <suprengine/tools/profiler.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+
+using namespace suprengine;
+
+namespace suprengine
+{
+	struct JobGroupState
+	{
+		/*
+		 * Jobs left to finish, with extra counts held until the group
+		 * is submitted and until its dependencies are completed.
+		 */
+		std::atomic<int> remaining_jobs { 2 };
+		/*
+		 * Dependencies left to complete, with an extra count held
+		 * while the group is being created.
+		 */
+		std::atomic<int> remaining_dependencies { 1 };
+		std::atomic<bool> is_completed { false };
+		bool is_submitted = false;
+
+		std::mutex mutex {};
+		/*
+		 * Jobs waiting for the dependencies to complete.
+		 */
+		std::vector<JobFunction> deferred_jobs {};
+		std::vector<SharedPtr<JobGroupState>> dependents {};
+	};
+}
+
+struct JobWorker
+{
+	const JobSystem* system = nullptr;
+	int index = INDEX_NONE;
+};
+
+static thread_local JobWorker current_worker {};
+
+bool JobGroup::is_completed() const
+{
+	if ( _state == nullptr ) return true;
+	return _state->is_completed.load( std::memory_order_acquire );
+}
+
+JobSystem::JobSystem( int threads_count )
+{
+	if ( threads_count < 0 )
+	{
+		threads_count = std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) ) - 1;
+	}
+
+	//	Register the calling thread as the first worker
+	_previous_worker_system = current_worker.system;
+	_previous_worker_index = current_worker.index;
+	current_worker = JobWorker { this, 0 };
+
+	_queues.reserve( threads_count + 1 );
+	for ( int i = 0; i < threads_count + 1; i++ )
+	{
+		_queues.push_back( std::make_unique<WorkerQueue>() );
+	}
+
+	_threads.reserve( threads_count );
+	for ( int i = 0; i < threads_count; i++ )
+	{
+		_threads.emplace_back( &JobSystem::_worker_loop, this, i + 1 );
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	wait_frame();
+
+	//	Stop workers
+	{
+		std::lock_guard lock( _sleep_mutex );
+		_is_stopping = true;
+	}
+	_sleep_condition.notify_all();
+
+	for ( std::thread& thread : _threads )
+	{
+		thread.join();
+	}
+
+	if ( current_worker.system == this )
+	{
+		current_worker = JobWorker { _previous_worker_system, _previous_worker_index };
+	}
+}
+
+JobGroup JobSystem::create_group( const std::vector<JobGroup>& dependencies )
+{
+	JobGroup group {};
+	group._state = std::make_shared<JobGroupState>();
+
+	//	Register as dependent of uncompleted groups
+	for ( const JobGroup& dependency : dependencies )
+	{
+		if ( !dependency.is_valid() ) continue;
+
+		JobGroupState& dependency_state = *dependency._state;
+		std::lock_guard lock( dependency_state.mutex );
+		if ( dependency_state.is_completed.load( std::memory_order_acquire ) ) continue;
+
+		group._state->remaining_dependencies.fetch_add( 1, std::memory_order_relaxed );
+		dependency_state.dependents.push_back( group._state );
+	}
+
+	//	Release the creation count
+	_release_dependency( group._state );
+	return group;
+}
+
+void JobSystem::add_job( const JobGroup& group, JobFunction function )
+{
+	ASSERT( group.is_valid() );
+
+	JobGroupState& state = *group._state;
+	_unfinished_jobs.fetch_add( 1, std::memory_order_relaxed );
+	state.remaining_jobs.fetch_add( 1, std::memory_order_relaxed );
+
+	{
+		std::lock_guard lock( state.mutex );
+		ASSERT_MSG( !state.is_submitted, "Can't add a job to an already submitted group!" );
+
+		//	Defer the job until dependencies are completed
+		if ( state.remaining_dependencies.load( std::memory_order_acquire ) > 0 )
+		{
+			state.deferred_jobs.push_back( std::move( function ) );
+			return;
+		}
+	}
+
+	_push_job( Job { std::move( function ), group._state } );
+}
+
+void JobSystem::submit( const JobGroup& group )
+{
+	ASSERT( group.is_valid() );
+
+	{
+		std::lock_guard lock( group._state->mutex );
+		ASSERT_MSG( !group._state->is_submitted, "Can't submit a group twice!" );
+		group._state->is_submitted = true;
+	}
+
+	//	Release the submission count
+	_finish_group_job( group._state );
+}
+
+JobGroup JobSystem::run( JobFunction function, const std::vector<JobGroup>& dependencies )
+{
+	JobGroup group = create_group( dependencies );
+	add_job( group, std::move( function ) );
+	submit( group );
+	return group;
+}
+
+JobGroup JobSystem::schedule_parallel_for(
+	const int count,
+	const ParallelForFunction& function,
+	int batch_size,
+	const std::vector<JobGroup>& dependencies
+)
+{
+	//	Aim a few batches per worker to balance the load through stealing
+	if ( batch_size <= 0 )
+	{
+		batch_size = std::max( 1, count / ( get_workers_count() * 4 ) );
+	}
+
+	JobGroup group = create_group( dependencies );
+	for ( int begin = 0; begin < count; begin += batch_size )
+	{
+		const int end = std::min( begin + batch_size, count );
+		add_job( group, [function, begin, end]() { function( begin, end ); } );
+	}
+	submit( group );
+
+	return group;
+}
+
+void JobSystem::parallel_for( const int count, const ParallelForFunction& function, const int batch_size )
+{
+	if ( count <= 0 ) return;
+
+	//	Avoid the scheduling cost when there is nothing to split
+	if ( get_workers_count() == 1 || ( batch_size > 0 && count <= batch_size ) )
+	{
+		function( 0, count );
+		return;
+	}
+
+	wait( schedule_parallel_for( count, function, batch_size ) );
+}
+
+void JobSystem::wait( const JobGroup& group )
+{
+	while ( !group.is_completed() )
+	{
+		if ( !_try_execute_job() )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::wait_frame()
+{
+	while ( _unfinished_jobs.load( std::memory_order_acquire ) > 0 )
+	{
+		if ( !_try_execute_job() )
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+int JobSystem::get_workers_count() const
+{
+	return static_cast<int>( _queues.size() );
+}
+
+int JobSystem::get_current_worker_index() const
+{
+	if ( current_worker.system != this ) return INDEX_NONE;
+	return current_worker.index;
+}
+
+void JobSystem::_worker_loop( const int worker_index )
+{
+	current_worker = JobWorker { this, worker_index };
+	Profiler::set_thread_name( "Worker " + std::to_string( worker_index ) );
+
+	Job job {};
+	while ( true )
+	{
+		if ( _try_pop_job( worker_index, &job ) )
+		{
+			_execute_job( job );
+			continue;
+		}
+
+		//	Sleep until jobs are queued
+		std::unique_lock lock( _sleep_mutex );
+		_sleep_condition.wait( lock,
+			[this]()
+			{
+				return _is_stopping || _queued_jobs.load( std::memory_order_acquire ) > 0;
+			}
+		);
+		if ( _is_stopping ) break;
+	}
+
+	current_worker = JobWorker {};
+}
+
+void JobSystem::_push_job( Job&& job )
+{
+	//	Push to the calling worker's queue, otherwise distribute between queues
+	int queue_index = get_current_worker_index();
+	if ( queue_index == INDEX_NONE )
+	{
+		queue_index = static_cast<int>( _next_queue.fetch_add( 1, std::memory_order_relaxed ) % _queues.size() );
+	}
+
+	{
+		WorkerQueue& queue = *_queues[queue_index];
+		std::lock_guard lock( queue.mutex );
+		queue.jobs.push_back( std::move( job ) );
+	}
+
+	//	Wake a sleeping worker
+	//	NOTE: The counter is modified under the sleep mutex to avoid missed wake-ups.
+	{
+		std::lock_guard lock( _sleep_mutex );
+		_queued_jobs.fetch_add( 1, std::memory_order_release );
+	}
+	_sleep_condition.notify_one();
+}
+
+bool JobSystem::_try_pop_job( const int worker_index, Job* job )
+{
+	const int queues_count = static_cast<int>( _queues.size() );
+	for ( int i = 0; i < queues_count; i++ )
+	{
+		const int queue_index = ( worker_index + i ) % queues_count;
+		WorkerQueue& queue = *_queues[queue_index];
+
+		std::lock_guard lock( queue.mutex );
+		if ( queue.jobs.empty() ) continue;
+
+		//	Pop the most recent own job, or steal the oldest one from others
+		if ( i == 0 )
+		{
+			*job = std::move( queue.jobs.back() );
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			*job = std::move( queue.jobs.front() );
+			queue.jobs.pop_front();
+		}
+
+		_queued_jobs.fetch_sub( 1, std::memory_order_relaxed );
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::_try_execute_job()
+{
+	int worker_index = get_current_worker_index();
+	if ( worker_index == INDEX_NONE )
+	{
+		worker_index = 0;
+	}
+
+	Job job {};
+	if ( !_try_pop_job( worker_index, &job ) ) return false;
+
+	_execute_job( job );
+	return true;
+}
+
+void JobSystem::_execute_job( Job& job )
+{
+	job.function();
+	job.function = nullptr;
+
+	_finish_group_job( job.group );
+	job.group.reset();
+
+	_unfinished_jobs.fetch_sub( 1, std::memory_order_release );
+}
+
+void JobSystem::_release_dependency( const SharedPtr<JobGroupState>& state )
+{
+	if ( state->remaining_dependencies.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;
+
+	//	Start deferred jobs
+	std::vector<JobFunction> jobs {};
+	{
+		std::lock_guard lock( state->mutex );
+		jobs.swap( state->deferred_jobs );
+	}
+
+	for ( JobFunction& function : jobs )
+	{
+		_push_job( Job { std::move( function ), state } );
+	}
+
+	//	Release the dependencies count
+	_finish_group_job( state );
+}
+
+void JobSystem::_finish_group_job( const SharedPtr<JobGroupState>& state )
+{
+	if ( state->remaining_jobs.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;
+
+	//	Complete the group
+	std::vector<SharedPtr<JobGroupState>> dependents {};
+	{
+		std::lock_guard lock( state->mutex );
+		state->is_completed.store( true, std::memory_order_release );
+		dependents.swap( state->dependents );
+	}
+
+	for ( const SharedPtr<JobGroupState>& dependent : dependents )
+	{
+		_release_dependency( dependent );
+	}
+}
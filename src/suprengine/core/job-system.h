@@ -0,0 +1,175 @@
+#pragma once
+
+#include <suprengine/utils/memory.h>
+#include <suprengine/utils/usings.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace suprengine
+{
+	using JobFunction = std::function<void()>;
+	using ParallelForFunction = std::function<void( int begin, int end )>;
+
+	struct JobGroupState;
+
+	/*
+	 * Handle to a group of jobs, completed once all of its jobs are done
+	 * and it has been submitted.
+	 * A group can depend on other groups, in which case its jobs are only
+	 * started once all of these are completed.
+	 */
+	class JobGroup
+	{
+	public:
+		JobGroup() = default;
+
+		bool is_valid() const { return _state != nullptr; }
+		/*
+		 * Returns whenever the group has been submitted and all of its
+		 * jobs are done. An invalid group is considered completed.
+		 */
+		bool is_completed() const;
+
+	private:
+		friend class JobSystem;
+
+	private:
+		SharedPtr<JobGroupState> _state {};
+	};
+
+	/*
+	 * Work-stealing thread pool.
+	 *
+	 * Each worker owns a deque of jobs: it pops its own jobs from the back
+	 * and steals other workers' jobs from the front when it runs out of them.
+	 * The thread creating the system is registered as the first worker and
+	 * participates by executing jobs while waiting on them.
+	 */
+	class JobSystem
+	{
+	public:
+		/*
+		 * Create a job system with the given amount of worker threads, not
+		 * including the calling thread.
+		 * By default, spawns a worker per hardware thread minus one.
+		 */
+		JobSystem( int threads_count = INDEX_NONE );
+		~JobSystem();
+
+		JobSystem( const JobSystem& ) = delete;
+		JobSystem& operator=( const JobSystem& ) = delete;
+
+		/*
+		 * Create a group of jobs which will wait on the given groups
+		 * to be completed before starting.
+		 * The group must be submitted once all of its jobs are added.
+		 */
+		JobGroup create_group( const std::vector<JobGroup>& dependencies = {} );
+		/*
+		 * Add a job to a group which has not been submitted yet.
+		 */
+		void add_job( const JobGroup& group, JobFunction function );
+		/*
+		 * Mark the group as complete of jobs, allowing it to be completed.
+		 */
+		void submit( const JobGroup& group );
+
+		/*
+		 * Create and submit a group of a single job.
+		 */
+		JobGroup run( JobFunction function, const std::vector<JobGroup>& dependencies = {} );
+		/*
+		 * Create and submit a group splitting the range [0; count[ into
+		 * batches of given size, each being a job.
+		 * A batch size of 0 computes one according to the workers count.
+		 */
+		JobGroup schedule_parallel_for(
+			int count,
+			const ParallelForFunction& function,
+			int batch_size = 0,
+			const std::vector<JobGroup>& dependencies = {}
+		);
+		/*
+		 * Split the range [0; count[ into batches of given size and
+		 * wait for them to be executed.
+		 */
+		void parallel_for( int count, const ParallelForFunction& function, int batch_size = 0 );
+
+		/*
+		 * Wait for the group to be completed, executing jobs meanwhile.
+		 */
+		void wait( const JobGroup& group );
+		/*
+		 * Wait for all added jobs to be executed, executing jobs meanwhile.
+		 * Called by the engine at the end of each frame, so no job outlives
+		 * the frame it has been added in.
+		 */
+		void wait_frame();
+
+		/*
+		 * Returns the amount of threads executing jobs, including the
+		 * thread which created the system.
+		 */
+		int get_workers_count() const;
+		/*
+		 * Returns the index of the calling thread inside the system,
+		 * or INDEX_NONE if it isn't one of its workers.
+		 */
+		int get_current_worker_index() const;
+
+	private:
+		struct Job
+		{
+			JobFunction function {};
+			SharedPtr<JobGroupState> group {};
+		};
+
+		struct WorkerQueue
+		{
+			std::mutex mutex {};
+			std::deque<Job> jobs {};
+		};
+
+	private:
+		void _worker_loop( int worker_index );
+
+		void _push_job( Job&& job );
+		bool _try_pop_job( int worker_index, Job* job );
+		bool _try_execute_job();
+		void _execute_job( Job& job );
+
+		void _release_dependency( const SharedPtr<JobGroupState>& state );
+		void _finish_group_job( const SharedPtr<JobGroupState>& state );
+
+	private:
+		std::vector<std::thread> _threads {};
+		std::vector<std::unique_ptr<WorkerQueue>> _queues {};
+
+		/*
+		 * Jobs pushed to a queue and not popped yet.
+		 */
+		std::atomic<int> _queued_jobs { 0 };
+		/*
+		 * Jobs added and not executed yet, including deferred ones.
+		 */
+		std::atomic<int> _unfinished_jobs { 0 };
+		std::atomic<uint32> _next_queue { 0 };
+
+		std::mutex _sleep_mutex {};
+		std::condition_variable _sleep_condition {};
+		bool _is_stopping = false;
+
+		/*
+		 * Worker the creating thread was registered as before this system,
+		 * restored on destruction so systems can be nested.
+		 */
+		const JobSystem* _previous_worker_system = nullptr;
+		int _previous_worker_index = INDEX_NONE;
+	};
+}
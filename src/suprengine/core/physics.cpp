@@ -3,28 +3,117 @@
 #include <suprengine/core/entity.h>
 #include <suprengine/components/collider.h>
 
+#include <suprengine/physics/sweep-and-prune-broadphase.h>
+
+#include <suprengine/tools/profiler.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+
 using namespace suprengine;
 
+Physics::Physics()
+	: _broadphase( std::make_unique<SweepAndPruneBroadphase>() )
+{}
+
+/*
+ * Order pairs by the physics list order of their colliders, as the
+ * previous brute-force loops did.
+ */
+static bool compare_pairs( const ColliderPair& a, const ColliderPair& b )
+{
+	if ( a.first->physics_order != b.first->physics_order ) return a.first->physics_order < b.first->physics_order;
+
+	return a.second->physics_order < b.second->physics_order;
+}
+
 void Physics::update()
 {
-	for ( auto& collider : colliders )
+	PROFILE_SCOPE( "Physics::update" );
+
+	//  Refresh order and bounds of active colliders
+	for ( int i = 0; i < static_cast<int>( colliders.size() ); i++ )
 	{
+		Collider* collider = colliders[i].get();
+		collider->physics_order = i;
+
 		//  Ignore a non-active collider
 		if ( !collider->is_active ) continue;
 
-		for ( auto& other : colliders )
+		collider->update_bounds();
+		_broadphase->update_collider( collider );
+	}
+
+	//  Find colliders potentially colliding
+	_candidate_pairs.clear();
+	{
+		PROFILE_SCOPE( "Physics::update::broadphase" );
+		_broadphase->compute_pairs( _candidate_pairs );
+	}
+
+	//  Test previous contacts again so separations are detected
+	_candidate_pairs.insert( _candidate_pairs.end(), _contacts.begin(), _contacts.end() );
+	_contacts.clear();
+
+	//  Sort pairs in a consistent order and remove duplicates
+	for ( ColliderPair& pair : _candidate_pairs )
+	{
+		if ( pair.second->physics_order < pair.first->physics_order )
 		{
-			//  Ignore self
-			if ( collider == other ) continue;
-			//  Ignore a non-active collider
-			if ( !other->is_active ) continue;
+			std::swap( pair.first, pair.second );
+		}
+	}
+	std::sort( _candidate_pairs.begin(), _candidate_pairs.end(), compare_pairs );
+	_candidate_pairs.erase(
+		std::unique(
+			_candidate_pairs.begin(), _candidate_pairs.end(),
+			[]( const ColliderPair& a, const ColliderPair& b )
+			{
+				return a.first == b.first && a.second == b.second;
+			}
+		),
+		_candidate_pairs.end()
+	);
+
+	//  Test each pair from both colliders, in the order of the previous
+	//  brute-force loops, so a collision keeps reporting an Enter followed 
+	//  by a Stay on its first frame and Stay events afterwards
+	_directed_pairs.clear();
+	for ( const ColliderPair& pair : _candidate_pairs )
+	{
+		_directed_pairs.push_back( pair );
+		_directed_pairs.push_back( ColliderPair { pair.second, pair.first } );
+	}
+	std::sort( _directed_pairs.begin(), _directed_pairs.end(), compare_pairs );
+
+	{
+		PROFILE_SCOPE( "Physics::update::narrowphase" );
+		for ( const ColliderPair& pair : _directed_pairs )
+		{
+			Collider* collider = pair.first;
+			Collider* other = pair.second;
+
+			//  Ignore a non-active collider, while keeping its current contact as is
+			if ( !collider->is_active || !other->is_active ) continue;
 			//  Ignore layers not in mask filter
 			if ( ( collider->mask & other->get_owner()->layer ) == 0 ) continue;
 
 			//  Update collisions between each other
-			bool is_active = collider->intersects( other );
-			collider->update_collision_with( other, is_active );
-			other->update_collision_with( collider, is_active );
+			const SharedPtr<Collider> collider_ptr = collider->as<Collider>();
+			const SharedPtr<Collider> other_ptr = other->as<Collider>();
+			const bool is_active = collider->intersects( other_ptr );
+			collider->update_collision_with( other_ptr, is_active );
+			other->update_collision_with( collider_ptr, is_active );
+		}
+	}
+
+	//  Keep pairs still in contact to test them again next update
+	for ( const ColliderPair& pair : _candidate_pairs )
+	{
+		if ( pair.first->is_colliding_with( pair.second ) || pair.second->is_colliding_with( pair.first ) )
+		{
+			_contacts.push_back( pair );
 		}
 	}
 }
@@ -55,6 +144,7 @@ void Physics::add_collider( SharedPtr<Collider> collider )
 			break;
 
 	colliders.insert( itr, collider );
+	_broadphase->add_collider( collider.get() );
 }
 
 void Physics::remove_collider( SharedPtr<Collider> collider )
@@ -63,4 +153,38 @@ void Physics::remove_collider( SharedPtr<Collider> collider )
 	if ( itr == colliders.end() ) return;
 
 	colliders.erase( itr );  //  Don't swap or you need to sort again!
-}
\ No newline at end of file
+	_broadphase->remove_collider( collider.get() );
+
+	//  Forget its contacts to avoid dangling pointers
+	Collider* collider_ptr = collider.get();
+	std::erase_if(
+		_contacts,
+		[collider_ptr]( const ColliderPair& pair )
+		{
+			return pair.first == collider_ptr || pair.second == collider_ptr;
+		}
+	);
+}
+
+void Physics::set_broadphase( std::unique_ptr<Broadphase> broadphase )
+{
+	ASSERT( broadphase != nullptr );
+
+	for ( auto& collider : colliders )
+	{
+		_broadphase->remove_collider( collider.get() );
+		broadphase->add_collider( collider.get() );
+	}
+
+	_broadphase = std::move( broadphase );
+}
+
+int Physics::get_colliders_count() const
+{
+	return static_cast<int>( colliders.size() );
+}
+
+int Physics::get_tested_pairs_count() const
+{
+	return static_cast<int>( _candidate_pairs.size() );
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <suprengine/physics/broadphase.h>
+
 #include <suprengine/utils/ray.h>
 #include <suprengine/utils/memory.h>
 
@@ -10,14 +12,44 @@ namespace suprengine
 	class Physics
 	{
 	public:
+		Physics();
+
 		void update();
 
 		bool raycast( const Ray& ray, RayHit* hit, const RayParams& params );
 
 		void add_collider( SharedPtr<Collider> collider );
 		void remove_collider( SharedPtr<Collider> collider );
+
+		/*
+		 * Replace the broadphase used to find potentially colliding pairs.
+		 * All registered colliders are moved into the new broadphase.
+		 * By default, a SweepAndPruneBroadphase is used.
+		 */
+		void set_broadphase( std::unique_ptr<Broadphase> broadphase );
+		Broadphase* get_broadphase() const { return _broadphase.get(); }
+
+		int get_colliders_count() const;
+		/*
+		 * Returns the amount of pairs tested by the narrowphase during
+		 * the last update.
+		 */
+		int get_tested_pairs_count() const;
 	
 	private:
 		std::vector<SharedPtr<Collider>> colliders;
+
+		std::unique_ptr<Broadphase> _broadphase;
+
+		/*
+		 * Pairs currently colliding, kept to be tested again during the
+		 * next update so that separations are reported.
+		 */
+		std::vector<ColliderPair> _contacts {};
+		std::vector<ColliderPair> _candidate_pairs {};
+		/*
+		 * Candidate pairs in both directions, as tested by the narrowphase.
+		 */
+		std::vector<ColliderPair> _directed_pairs {};
 	};
-}
\ No newline at end of file
+}
@@ -87,6 +87,16 @@ void RenderBatch::remove_renderer( SharedPtr<Renderer> renderer )
 	list.erase( itr );  //  Don't swap or you need to sort again!
 }
 
+void RenderBatch::set_interpolation_alpha( const float alpha )
+{
+	_interpolation_alpha = alpha;
+}
+
+float RenderBatch::get_interpolation_alpha() const
+{
+	return _interpolation_alpha;
+}
+
 void RenderBatch::init()
 {
 	Assets::set_render_batch( this );
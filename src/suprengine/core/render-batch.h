@@ -17,17 +17,17 @@
 
 namespace suprengine
 {
-	static inline const char* const SHADER_LIT_MESH = "suprengine::lit-mesh";
+	inline constexpr char SHADER_LIT_MESH[] = "suprengine::lit-mesh";
 
-	static inline const char* const TEXTURE_WHITE = "suprengine::white";
-	static inline const char* const TEXTURE_LARGE_GRID = "suprengine::large-grid";
-	static inline const char* const TEXTURE_MEDIUM_GRID = "suprengine::medium-grid";
+	inline constexpr char TEXTURE_WHITE[] = "suprengine::white";
+	inline constexpr char TEXTURE_LARGE_GRID[] = "suprengine::large-grid";
+	inline constexpr char TEXTURE_MEDIUM_GRID[] = "suprengine::medium-grid";
 
-	static inline const char* const MESH_ARROW = "suprengine::arrow";
-	static inline const char* const MESH_CUBE = "suprengine::cube";
-	static inline const char* const MESH_CYLINDER = "suprengine::cylinder";
-	static inline const char* const MESH_SPHERE = "suprengine::sphere";
-	static inline const char* const MESH_PLANE = "suprengine::plane";
+	inline constexpr char MESH_ARROW[] = "suprengine::arrow";
+	inline constexpr char MESH_CUBE[] = "suprengine::cube";
+	inline constexpr char MESH_CYLINDER[] = "suprengine::cylinder";
+	inline constexpr char MESH_SPHERE[] = "suprengine::sphere";
+	inline constexpr char MESH_PLANE[] = "suprengine::plane";
 
 	class Engine;
 	class Renderer;
@@ -89,6 +89,18 @@ namespace suprengine
 		void add_renderer( SharedPtr<Renderer> renderer );
 		void remove_renderer( SharedPtr<Renderer> renderer );
 
+		/*
+		 * Set the progress between the last two fixed simulation ticks,
+		 * set by the engine before each render.
+		 */
+		void set_interpolation_alpha( float alpha );
+		/*
+		 * Returns the progress, between 0.0f and 1.0f, between the last 
+		 * two fixed simulation ticks, allowing renderers to interpolate 
+		 * simulated states. Always 1.0f without fixed timestep.
+		 */
+		float get_interpolation_alpha() const;
+
 	public:
 		virtual void init();
 		virtual bool init_imgui() = 0;
@@ -187,6 +199,12 @@ namespace suprengine
 
 		int get_renderers_count( RenderPhase phase ) const;
 
+		/*
+		 * Returns whenever the render batch runs without any graphics 
+		 * backend, in which case assets aren't uploaded to a GPU.
+		 */
+		virtual bool is_headless() const { return false; }
+
 	protected:
 		void _render_phase( RenderPhase phase );
 
@@ -197,5 +215,6 @@ namespace suprengine
 		AmbientLightInfos _ambient_light;
 
 		Color _background_color { Color::black };
+		float _interpolation_alpha = 1.0f;
 	};
 }
\ No newline at end of file
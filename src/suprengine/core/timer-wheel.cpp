@@ -0,0 +1,405 @@
+#include "timer-wheel.h"
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace suprengine;
+
+constexpr uint64 SLOT_MASK = TimerWheel::SLOTS_COUNT - 1;
+
+TimerWheel::TimerWheel()
+{
+	std::fill( std::begin( _slots ), std::end( _slots ), INDEX_NONE );
+}
+
+TimerHandle TimerWheel::add( const Timer& timer )
+{
+	//  Reuse a free node
+	int index = _free_head;
+	if ( index == INDEX_NONE )
+	{
+		index = static_cast<int>( _nodes.size() );
+		_nodes.emplace_back();
+	}
+	else
+	{
+		_free_head = _nodes[index].next;
+	}
+
+	TimerNode& node = _nodes[index];
+	node.callback = timer.callback;
+	node.interval_ticks = _to_ticks( timer.max_time );
+	node.repetitions = timer.repetitions;
+	node.due_tick = _current_tick + node.interval_ticks;
+	node.is_used = true;
+	node.is_paused = false;
+	node.is_cancelled = false;
+	_link( index );
+
+	_timers_count++;
+	return TimerHandle( this, static_cast<uint32>( index ), node.generation );
+}
+
+void TimerWheel::update( const float dt )
+{
+	_pending_time += dt;
+	if ( _pending_time < TICK_DURATION ) return;
+
+	const uint64 ticks = static_cast<uint64>( _pending_time / TICK_DURATION );
+	_pending_time -= ticks * TICK_DURATION;
+
+	const uint64 target_tick = _current_tick + ticks;
+	while ( _current_tick < target_tick )
+	{
+		//  Skip time when there is nothing to wait for
+		if ( _timers_count == 0 )
+		{
+			_current_tick = target_tick;
+			break;
+		}
+
+		_current_tick++;
+
+		//  Cascade the timers of coarser levels whose block is reached,
+		//  starting from the coarsest one
+		if ( ( _current_tick & SLOT_MASK ) == 0 )
+		{
+			int level = 1;
+			while ( level + 1 < LEVELS_COUNT
+				&& ( _current_tick & ( ( uint64 { 1 } << ( SLOT_BITS * ( level + 1 ) ) ) - 1 ) ) == 0 )
+			{
+				level++;
+			}
+
+			for ( ; level > 0; level-- )
+			{
+				_cascade( level );
+			}
+		}
+
+		//  Call due timers
+		int& head = _slots[_current_tick & SLOT_MASK];
+		while ( head != INDEX_NONE )
+		{
+			const int index = head;
+			_unlink( index );
+
+			//  Call the callback, moved out as it may add timers and so
+			//  reallocate the nodes
+			lambda callback = std::move( _nodes[index].callback );
+			_running_index = index;
+			callback();
+			_running_index = INDEX_NONE;
+
+			TimerNode& node = _nodes[index];
+			node.callback = std::move( callback );
+
+			//  Check for remaining repetitions
+			if ( node.is_cancelled || node.repetitions == 1 )
+			{
+				_free( index );
+				continue;
+			}
+			if ( node.repetitions > 1 )
+			{
+				node.repetitions--;
+			}
+
+			//  Loop the timer, or wait for its resume
+			if ( node.is_paused )
+			{
+				node.due_tick = node.interval_ticks;
+				continue;
+			}
+
+			//  Call a timer at most once per update, delaying its next call to
+			//  the next update rather than catching up on shorter intervals
+			node.due_tick = std::max( _current_tick + node.interval_ticks, target_tick + 1 );
+			_link( index );
+		}
+	}
+}
+
+void TimerWheel::clear()
+{
+	//  Free the nodes rather than dropping them, so their generations keep
+	//  increasing and existing handles can't match new timers
+	for ( int index = 0; index < static_cast<int>( _nodes.size() ); index++ )
+	{
+		TimerNode& node = _nodes[index];
+		if ( !node.is_used || node.is_cancelled ) continue;
+
+		//  The running timer is freed after its callback
+		if ( index == _running_index )
+		{
+			node.is_cancelled = true;
+			continue;
+		}
+
+		_free( index );
+	}
+
+	std::fill( std::begin( _slots ), std::end( _slots ), INDEX_NONE );
+}
+
+bool TimerWheel::is_valid( const TimerHandle handle ) const
+{
+	return _find_node( handle ) != nullptr;
+}
+
+bool TimerWheel::is_paused( const TimerHandle handle ) const
+{
+	const TimerNode* node = _find_node( handle );
+	if ( node == nullptr ) return false;
+
+	return node->is_paused;
+}
+
+float TimerWheel::get_remaining_time( const TimerHandle handle ) const
+{
+	const TimerNode* node = _find_node( handle );
+	if ( node == nullptr ) return 0.0f;
+
+	if ( node->is_paused ) return node->due_tick * TICK_DURATION;
+	return ( node->due_tick - _current_tick ) * TICK_DURATION - _pending_time;
+}
+
+void TimerWheel::cancel( const TimerHandle handle )
+{
+	TimerNode* node = _find_node( handle );
+	if ( node == nullptr ) return;
+
+	const int index = static_cast<int>( handle._index );
+	if ( index == _running_index )
+	{
+		node->is_cancelled = true;
+		return;
+	}
+
+	if ( !node->is_paused )
+	{
+		_unlink( index );
+	}
+	_free( index );
+}
+
+void TimerWheel::pause( const TimerHandle handle )
+{
+	TimerNode* node = _find_node( handle );
+	if ( node == nullptr || node->is_paused ) return;
+
+	node->is_paused = true;
+
+	//  The running timer is handled after its callback
+	const int index = static_cast<int>( handle._index );
+	if ( index == _running_index ) return;
+
+	_unlink( index );
+	node->due_tick -= _current_tick;
+}
+
+void TimerWheel::resume( const TimerHandle handle )
+{
+	TimerNode* node = _find_node( handle );
+	if ( node == nullptr || !node->is_paused ) return;
+
+	node->is_paused = false;
+
+	const int index = static_cast<int>( handle._index );
+	if ( index == _running_index ) return;
+
+	//  Wait for the next tick at least, as a timer paused while its tick
+	//  was being called has no remaining ticks, and that tick is past
+	node->due_tick = _current_tick + std::max<uint64>( node->due_tick, 1 );
+	_link( index );
+}
+
+void TimerWheel::reschedule( const TimerHandle handle, const float time )
+{
+	TimerNode* node = _find_node( handle );
+	if ( node == nullptr ) return;
+
+	node->interval_ticks = _to_ticks( time );
+
+	//  The running timer is looped with its new interval after its callback
+	const int index = static_cast<int>( handle._index );
+	if ( index == _running_index ) return;
+
+	if ( node->is_paused )
+	{
+		node->due_tick = node->interval_ticks;
+		return;
+	}
+
+	_unlink( index );
+	node->due_tick = _current_tick + node->interval_ticks;
+	_link( index );
+}
+
+int TimerWheel::get_timers_count() const
+{
+	return _timers_count;
+}
+
+uint32 TimerWheel::_to_ticks( const float time )
+{
+	return std::max( 1u, static_cast<uint32>( std::round( time / TICK_DURATION ) ) );
+}
+
+TimerWheel::TimerNode* TimerWheel::_find_node( const TimerHandle handle )
+{
+	return const_cast<TimerNode*>( static_cast<const TimerWheel*>( this )->_find_node( handle ) );
+}
+
+const TimerWheel::TimerNode* TimerWheel::_find_node( const TimerHandle handle ) const
+{
+	if ( handle._wheel != this || handle._index >= _nodes.size() ) return nullptr;
+
+	const TimerNode& node = _nodes[handle._index];
+	if ( !node.is_used || node.is_cancelled || node.generation != handle._generation ) return nullptr;
+
+	return &node;
+}
+
+void TimerWheel::_link( const int index )
+{
+	TimerNode& node = _nodes[index];
+	ASSERT( node.due_tick >= _current_tick );
+
+	//  Find the finest level sharing the current block with the due tick
+	int level = 0;
+	while ( level < LEVELS_COUNT - 1
+		&& ( node.due_tick >> ( SLOT_BITS * ( level + 1 ) ) ) != ( _current_tick >> ( SLOT_BITS * ( level + 1 ) ) ) )
+	{
+		level++;
+	}
+
+	//  Clamp timers farther than the wheel range to the last slot to be cascaded
+	uint64 slot_tick = node.due_tick;
+	if ( level == LEVELS_COUNT - 1
+		&& ( node.due_tick >> ( SLOT_BITS * LEVELS_COUNT ) ) != ( _current_tick >> ( SLOT_BITS * LEVELS_COUNT ) ) )
+	{
+		slot_tick = _current_tick + ( SLOT_MASK << ( SLOT_BITS * level ) );
+	}
+
+	const int slot = level * SLOTS_COUNT + static_cast<int>( ( slot_tick >> ( SLOT_BITS * level ) ) & SLOT_MASK );
+
+	//  Insert at the front of the slot
+	node.slot = slot;
+	node.previous = INDEX_NONE;
+	node.next = _slots[slot];
+	if ( node.next != INDEX_NONE )
+	{
+		_nodes[node.next].previous = index;
+	}
+	_slots[slot] = index;
+}
+
+void TimerWheel::_unlink( const int index )
+{
+	TimerNode& node = _nodes[index];
+	ASSERT( node.slot != INDEX_NONE );
+
+	if ( node.previous != INDEX_NONE )
+	{
+		_nodes[node.previous].next = node.next;
+	}
+	else
+	{
+		_slots[node.slot] = node.next;
+	}
+
+	if ( node.next != INDEX_NONE )
+	{
+		_nodes[node.next].previous = node.previous;
+	}
+
+	node.slot = INDEX_NONE;
+	node.previous = INDEX_NONE;
+	node.next = INDEX_NONE;
+}
+
+void TimerWheel::_cascade( const int level )
+{
+	const int slot = level * SLOTS_COUNT + static_cast<int>( ( _current_tick >> ( SLOT_BITS * level ) ) & SLOT_MASK );
+
+	//  Re-link timers of the slot into finer levels
+	int index = _slots[slot];
+	_slots[slot] = INDEX_NONE;
+	while ( index != INDEX_NONE )
+	{
+		const int next = _nodes[index].next;
+		_nodes[index].slot = INDEX_NONE;
+		_link( index );
+		index = next;
+	}
+}
+
+void TimerWheel::_free( const int index )
+{
+	TimerNode& node = _nodes[index];
+	node.callback = nullptr;
+	node.is_used = false;
+	node.is_cancelled = false;
+	node.is_paused = false;
+	node.slot = INDEX_NONE;
+	node.previous = INDEX_NONE;
+
+	//  Invalidate existing handles
+	node.generation++;
+	if ( node.generation == 0 )
+	{
+		node.generation = 1;
+	}
+
+	node.next = _free_head;
+	_free_head = index;
+	_timers_count--;
+}
+
+bool TimerHandle::is_valid() const
+{
+	return _wheel != nullptr && _wheel->is_valid( *this );
+}
+
+bool TimerHandle::is_paused() const
+{
+	return _wheel != nullptr && _wheel->is_paused( *this );
+}
+
+float TimerHandle::get_remaining_time() const
+{
+	if ( _wheel == nullptr ) return 0.0f;
+
+	return _wheel->get_remaining_time( *this );
+}
+
+void TimerHandle::cancel()
+{
+	if ( _wheel == nullptr ) return;
+
+	_wheel->cancel( *this );
+}
+
+void TimerHandle::pause()
+{
+	if ( _wheel == nullptr ) return;
+
+	_wheel->pause( *this );
+}
+
+void TimerHandle::resume()
+{
+	if ( _wheel == nullptr ) return;
+
+	_wheel->resume( *this );
+}
+
+void TimerHandle::reschedule( const float time )
+{
+	if ( _wheel == nullptr ) return;
+
+	_wheel->reschedule( *this, time );
+}
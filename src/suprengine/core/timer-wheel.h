@@ -0,0 +1,125 @@
+#pragma once
+
+#include <suprengine/utils/timer.h>
+
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Hierarchical timing wheel storing timers.
+	 *
+	 * Time is split into ticks of TICK_DURATION. Timers due within the
+	 * current block of 256 ticks are stored in the first level, indexed by
+	 * their due tick, while farther timers are stored in coarser levels
+	 * and cascaded down once their block is reached. An update thus only
+	 * touches the timers that are due, and adding, cancelling or
+	 * rescheduling a timer is done in constant time.
+	 *
+	 * Timers are stored in a pool and reused, so repeating timers don't
+	 * allocate.
+	 */
+	class TimerWheel
+	{
+	public:
+		/*
+		 * Duration of a tick in seconds.
+		 */
+		static constexpr float TICK_DURATION = 0.001f;
+
+		static constexpr int LEVELS_COUNT = 4;
+		static constexpr int SLOT_BITS = 8;
+		static constexpr int SLOTS_COUNT = 1 << SLOT_BITS;
+
+	public:
+		TimerWheel();
+		TimerWheel( const TimerWheel& ) = delete;
+		TimerWheel& operator=( const TimerWheel& ) = delete;
+
+		TimerHandle add( const Timer& timer );
+		/*
+		 * Advance time and call the callbacks of due timers.
+		 * A timer is called at most once per update: a repeating timer
+		 * shorter than the elapsed time is called once and then waits
+		 * for the next update.
+		 */
+		void update( float dt );
+		/*
+		 * Remove all timers without calling their callbacks, invalidating
+		 * their handles.
+		 */
+		void clear();
+
+		bool is_valid( TimerHandle handle ) const;
+		bool is_paused( TimerHandle handle ) const;
+		float get_remaining_time( TimerHandle handle ) const;
+
+		void cancel( TimerHandle handle );
+		void pause( TimerHandle handle );
+		void resume( TimerHandle handle );
+		void reschedule( TimerHandle handle, float time );
+
+		/*
+		 * Returns the amount of timers, including paused ones.
+		 */
+		int get_timers_count() const;
+
+	private:
+		struct TimerNode
+		{
+			lambda callback {};
+
+			/*
+			 * Tick at which the timer is due, or its remaining ticks
+			 * while paused.
+			 */
+			uint64 due_tick = 0;
+			uint32 interval_ticks = 1;
+			/*
+			 * Remaining number of calls, 0 for infinite looping.
+			 */
+			uint32 repetitions = 1;
+
+			uint32 generation = 1;
+			/*
+			 * Intrusive links inside a slot, or the free list.
+			 */
+			int previous = INDEX_NONE;
+			int next = INDEX_NONE;
+			int slot = INDEX_NONE;
+
+			bool is_used = false;
+			bool is_paused = false;
+			bool is_cancelled = false;
+		};
+
+	private:
+		static uint32 _to_ticks( float time );
+
+		TimerNode* _find_node( TimerHandle handle );
+		const TimerNode* _find_node( TimerHandle handle ) const;
+
+		void _link( int index );
+		void _unlink( int index );
+		void _cascade( int level );
+		void _free( int index );
+
+	private:
+		std::vector<TimerNode> _nodes {};
+		int _free_head = INDEX_NONE;
+		int _timers_count = 0;
+
+		/*
+		 * Heads of the lists of each slot, level after level.
+		 */
+		int _slots[LEVELS_COUNT * SLOTS_COUNT];
+
+		uint64 _current_tick = 0;
+		float _pending_time = 0.0f;
+
+		/*
+		 * Node whose callback is being called.
+		 */
+		int _running_index = INDEX_NONE;
+	};
+}
@@ -1,19 +1,42 @@
 #include "updater.h"
 #include <suprengine/math/math.h>
+#include <suprengine/utils/assert.h>
 
 #include <SDL_timer.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace suprengine;
 
-constexpr uint32 MAX_DT = 50;
+namespace chrono = std::chrono;
+
+constexpr float MAX_DT = 0.05f;
 
 void Updater::compute_delta_time()
 {
 	_frame_start = SDL_GetTicks();
-	uint32_t dt = _frame_start - _last_frame;
-	_last_frame = _frame_start;
+	_frame_start_time = clock::now();
+
+	//  Skip the first frame, having no previous frame to compare with
+	if ( _last_frame_time == clock::time_point {} )
+	{
+		_last_frame_time = _frame_start_time;
+	}
+
+	const float dt = chrono::duration<float>( _frame_start_time - _last_frame_time ).count();
+	_last_frame_time = _frame_start_time;
 
-	_delta_time = math::min( dt, MAX_DT ) / 1000.0f;
+	_unclamped_delta_time = dt;
+	_delta_time = math::min( dt, MAX_DT );
+
+	//  Record the real frame time
+	if ( dt > 0.0f )
+	{
+		_frame_times[_frame_times_index] = dt * 1000.0f;
+		_frame_times_index = ( _frame_times_index + 1 ) % FRAME_TIMES_COUNT;
+		_frame_times_count = math::min( _frame_times_count + 1, FRAME_TIMES_COUNT );
+	}
 }
 
 float Updater::get_scaled_delta_time() const
@@ -26,29 +49,36 @@ float Updater::get_unscaled_delta_time() const
 	return _delta_time;
 }
 
+float Updater::get_unclamped_delta_time() const
+{
+	return _unclamped_delta_time;
+}
+
 void Updater::delay_time()
 {
-	if ( !is_fps_capped ) return;
+	if ( !is_fps_capped || target_fps <= 0 ) return;
+
+	const clock::time_point target_time = _frame_start_time
+		+ chrono::duration_cast<clock::duration>( chrono::duration<double>( 1.0 / target_fps ) );
+
+	//  Sleep until the spin window, as sleeping may overshoot by a scheduler quantum
+	const clock::time_point spin_time = target_time
+		- chrono::duration_cast<clock::duration>( chrono::duration<float>( spin_window ) );
+	if ( clock::now() < spin_time )
+	{
+		std::this_thread::sleep_until( spin_time );
+	}
 
-	uint32 target_frame_time = static_cast<uint32>( 1.0f / target_fps * 1000.0f );
-	uint32 frame_time = SDL_GetTicks() - _frame_start;
-	if ( frame_time < target_frame_time )
+	//  Spin for the remaining time
+	while ( clock::now() < target_time )
 	{
-		SDL_Delay( target_frame_time - frame_time );
+		std::this_thread::yield();
 	}
 }
 
 void Updater::accumulate_seconds( float dt ) 
 { 
-	float last_seconds = _accumulated_seconds;
 	_accumulated_seconds += dt;
-
-	//  NOTE: FPS counter is dependent on time scale, which shouldn't be the case!
-	//  TODO: Don't use _accumulated_seconds since it's time scale dependent 
-	if ( (int)math::floor( last_seconds ) != (int)math::floor( _accumulated_seconds ) )
-	{
-		_fps = (uint32_t)math::floor( 1.0f / get_unscaled_delta_time() );
-	}
 }
 
 float Updater::get_accumulated_seconds() const 
@@ -58,10 +88,69 @@ float Updater::get_accumulated_seconds() const
 
 uint32_t Updater::get_fps() const
 {
-	return _fps;
+	const FrameTimeStats stats = get_frame_time_stats();
+	if ( stats.average <= 0.0f ) return 0;
+
+	return static_cast<uint32>( math::round( 1000.0f / stats.average ) );
+}
+
+FrameTimeStats Updater::get_frame_time_stats() const
+{
+	FrameTimeStats stats {};
+	stats.frames_count = _frame_times_count;
+	if ( _frame_times_count == 0 ) return stats;
+
+	float frame_times[FRAME_TIMES_COUNT];
+	std::copy_n( _frame_times, _frame_times_count, frame_times );
+	std::sort( frame_times, frame_times + _frame_times_count );
+
+	float total_time = 0.0f;
+	for ( int i = 0; i < _frame_times_count; i++ )
+	{
+		total_time += frame_times[i];
+	}
+
+	//  Nearest-rank percentile
+	const int p99_index = math::min(
+		static_cast<int>( math::ceil( _frame_times_count * 0.99f ) ) - 1,
+		_frame_times_count - 1
+	);
+
+	stats.min = frame_times[0];
+	stats.average = total_time / _frame_times_count;
+	stats.max = frame_times[_frame_times_count - 1];
+	stats.p99 = frame_times[math::max( p99_index, 0 )];
+	return stats;
 }
 
 uint32_t Updater::get_frame_tick() const
 {
 	return _frame_start;
 }
+
+int Updater::compute_fixed_ticks( const float dt )
+{
+	ASSERT( fixed_delta_time > 0.0f );
+	if ( fixed_delta_time <= 0.0f ) return 0;
+
+	_fixed_accumulator += dt;
+
+	int ticks_count = static_cast<int>( _fixed_accumulator / fixed_delta_time );
+	if ( ticks_count > max_fixed_ticks_per_frame )
+	{
+		//  Drop the late time, only keeping the progress towards the next tick
+		ticks_count = max_fixed_ticks_per_frame;
+		_fixed_accumulator = math::fmod( _fixed_accumulator, fixed_delta_time );
+		return ticks_count;
+	}
+
+	_fixed_accumulator -= ticks_count * fixed_delta_time;
+	return ticks_count;
+}
+
+float Updater::get_interpolation_alpha() const
+{
+	if ( !is_fixed_timestep || fixed_delta_time <= 0.0f ) return 1.0f;
+
+	return math::clamp( _fixed_accumulator / fixed_delta_time, 0.0f, 1.0f );
+}
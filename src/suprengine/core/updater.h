@@ -2,10 +2,31 @@
 
 #include <suprengine/utils/usings.h>
 
+#include <chrono>
+
 namespace suprengine
 {
+	/*
+	 * Frame times statistics, in milliseconds, over the last frames.
+	 */
+	struct FrameTimeStats
+	{
+		float min = 0.0f;
+		float average = 0.0f;
+		float max = 0.0f;
+		float p99 = 0.0f;
+
+		int frames_count = 0;
+	};
+
 	class Updater
 	{
+	public:
+		/*
+		 * Amount of last frames kept for the frame times statistics.
+		 */
+		static constexpr int FRAME_TIMES_COUNT = 240;
+
 	public:
 		Updater() {};
 		Updater( const Updater& ) = delete;
@@ -14,30 +35,93 @@ namespace suprengine
 		void compute_delta_time();
 		float get_scaled_delta_time() const;
 		float get_unscaled_delta_time() const;
+		/*
+		 * Returns the real duration of the last frame, without the time
+		 * scale nor the maximum delta time applied to the other delta times.
+		 */
+		float get_unclamped_delta_time() const;
 
 		/*
 		 * Delays main thread to the target frame rate.
+		 * It sleeps until 'spin_window' before the end of the frame, then
+		 * spins for the remaining time to avoid the sleep overshoot.
 		 * If 'is_fps_capped' set to false, this function will result in no operation.
 		 */
 		void delay_time();
 
 		void accumulate_seconds( float dt );
 		float get_accumulated_seconds() const;
+		/*
+		 * Returns the frame rate averaged over the last frames, independently
+		 * of the time scale.
+		 */
 		uint32 get_fps() const;
+		/*
+		 * Returns statistics of the real duration of the last frames,
+		 * delay included and independently of the time scale.
+		 */
+		FrameTimeStats get_frame_time_stats() const;
 
 		uint32 get_frame_tick() const;
 
+		/*
+		 * Accumulate the frame's delta time and returns the amount of 
+		 * fixed ticks to run, each lasting 'fixed_delta_time'.
+		 * The amount is capped by 'max_fixed_ticks_per_frame', in which
+		 * case the late time is dropped so the simulation doesn't spiral.
+		 * This cap replaces the maximum delta time, so the given delta
+		 * time should be the unclamped one.
+		 * 'fixed_delta_time' must be positive, otherwise no tick is run.
+		 */
+		int compute_fixed_ticks( float dt );
+		/*
+		 * Returns the progress, between 0.0f and 1.0f, of the accumulated 
+		 * time towards the next fixed tick. Always returns 1.0f without
+		 * fixed timestep.
+		 * 
+		 * The engine passes it to the render batch, so renderers blend the
+		 * previous and current simulated states of their transform.
+		 */
+		float get_interpolation_alpha() const;
+
 	public:
 		float time_scale = 1.0f;
 		int target_fps = 60;
 		bool is_fps_capped = true;
+		/*
+		 * Duration in seconds before the end of a frame during which the
+		 * frame limiter spins instead of sleeping. Larger values trade CPU
+		 * usage for precision on platforms with a coarse sleep granularity.
+		 */
+		float spin_window = 0.002f;
+
+		/*
+		 * Whenever the engine updates the simulation by fixed ticks
+		 * instead of once per frame with a variable delta time.
+		 */
+		bool is_fixed_timestep = false;
+		float fixed_delta_time = 1.0f / 60.0f;
+		int max_fixed_ticks_per_frame = 5;
+
+	private:
+		using clock = std::chrono::steady_clock;
 
 	private:
+		clock::time_point _frame_start_time {};
+		clock::time_point _last_frame_time {};
 		uint32 _frame_start = 0u;
-		uint32 _last_frame = 0u;
-		uint32 _fps = 0;
+
+		/*
+		 * Ring buffer of the last frame times in milliseconds.
+		 */
+		float _frame_times[FRAME_TIMES_COUNT] {};
+		int _frame_times_index = 0;
+		int _frame_times_count = 0;
 
 		float _accumulated_seconds = 0.0f;
 		float _delta_time = 0.0f;
+		float _unclamped_delta_time = 0.0f;
+
+		float _fixed_accumulator = 0.0f;
 	};
-}
\ No newline at end of file
+}
@@ -6,10 +6,17 @@
 
 using namespace suprengine;
 
-Window::Window( const WindowInfos& infos )
+Window::Window( const WindowInfos& infos, const bool is_headless )
 	: _size( Vec2 { static_cast<float>( infos.width ), static_cast<float>( infos.height ) } ),
 	  _title( infos.title )
 {
+	if ( is_headless )
+	{
+		_current_size = _size;
+		_mode = infos.mode;
+		return;
+	}
+
 	int flags = SDL_WINDOW_OPENGL;
 
 	if ( infos.is_resizable )
@@ -43,6 +50,12 @@ void Window::set_mode( const WindowMode mode )
 {
 	if ( mode == _mode ) return;
 
+	if ( is_headless() )
+	{
+		_mode = mode;
+		return;
+	}
+
 	SDL_DisplayMode display {};
 	SDL_GetCurrentDisplayMode( 0, &display );
 
@@ -97,7 +110,10 @@ void Window::set_size( const Vec2 size, const bool is_new_size )
 	_current_size = size;
 
 	//  resize window
-	SDL_SetWindowSize( _sdl_window, static_cast<int>( size.x ), static_cast<int>( size.y ) );
+	if ( !is_headless() )
+	{
+		SDL_SetWindowSize( _sdl_window, static_cast<int>( size.x ), static_cast<int>( size.y ) );
+	}
 
 	//  broadcast event
 	on_size_changed.invoke( size, old_size );
@@ -28,7 +28,11 @@ namespace suprengine
 	class Window
 	{
 	public:
-		explicit Window( const WindowInfos& infos );
+		/*
+		 * Create the window. A headless window doesn't create any
+		 * SDL window and only keeps track of its size and mode.
+		 */
+		explicit Window( const WindowInfos& infos, bool is_headless = false );
 
 		Window( const Window& ) = delete;
 		Window& operator=( const Window& ) = delete;
@@ -41,6 +45,7 @@ namespace suprengine
 		Vec2 get_size() const { return _current_size; }
 
 		SDL_Window* get_sdl_window() const { return _sdl_window; }
+		bool is_headless() const { return _sdl_window == nullptr; }
 
 	public:
 		/*
@@ -5,6 +5,8 @@
 #include <suprengine/input/buttons.h>
 #include <suprengine/math/vec2.h>
 
+#include <suprengine/utils/string-id.h>
+
 namespace suprengine
 {
 	class InputManager;
@@ -34,13 +36,14 @@ namespace suprengine
 	{
 	public:
 		explicit InputActionBase( const std::string& name, InputManager* inputs )
-			: name( name ), _inputs( inputs ) {}
+			: name( name ), id( StringId::intern( name ) ), _inputs( inputs ) {}
 		virtual ~InputActionBase() = default;
 
 		virtual void populate_imgui( const InputContext& context ) {};
 
 	public:
 		std::string name {};
+		StringId id {};
 
 	protected:
 		InputManager* _inputs = nullptr;
@@ -55,11 +55,11 @@ namespace suprengine
 			return input_action;
 		}
 		template <typename T>
-		InputAction<T>* get_action( const std::string& name ) const
+		InputAction<T>* get_action( const StringId id ) const
 		{
 			for ( InputActionBase* input_action : _input_actions )
 			{
-				if ( input_action->name == name )
+				if ( input_action->id == id )
 				{
 					return dynamic_cast<InputAction<T>*>( input_action );
 				}
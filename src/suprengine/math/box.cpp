@@ -1,5 +1,7 @@
 #include "box.h"
 
+#include <suprengine/math/math.h>
+
 using namespace suprengine;
 
 Box Box::one {
@@ -22,3 +24,47 @@ Vec3 Box::get_size() const
 {
 	return max - min;
 }
+
+float Box::get_surface_area() const
+{
+	const Vec3 size = get_size();
+	return 2.0f * ( size.x * size.y + size.y * size.z + size.z * size.x );
+}
+
+bool Box::intersects( const Box& other ) const
+{
+	return min.x <= other.max.x && other.min.x <= max.x
+		&& min.y <= other.max.y && other.min.y <= max.y
+		&& min.z <= other.max.z && other.min.z <= max.z;
+}
+
+bool Box::contains( const Box& other ) const
+{
+	return min.x <= other.min.x && other.max.x <= max.x
+		&& min.y <= other.min.y && other.max.y <= max.y
+		&& min.z <= other.min.z && other.max.z <= max.z;
+}
+
+Box Box::expanded( const float margin ) const
+{
+	return Box {
+		min - Vec3( margin ),
+		max + Vec3( margin )
+	};
+}
+
+Box Box::merge( const Box& a, const Box& b )
+{
+	return Box {
+		Vec3 {
+			math::min( a.min.x, b.min.x ),
+			math::min( a.min.y, b.min.y ),
+			math::min( a.min.z, b.min.z ),
+		},
+		Vec3 {
+			math::max( a.max.x, b.max.x ),
+			math::max( a.max.y, b.max.y ),
+			math::max( a.max.z, b.max.z ),
+		}
+	};
+}
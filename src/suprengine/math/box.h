@@ -17,6 +17,31 @@ namespace suprengine
 	public:
 		Vec3 get_center() const;
 		Vec3 get_size() const;
+		/*
+		 * Returns the total area of the box faces.
+		 * Used as a cost heuristic by the AABB tree broadphase.
+		 */
+		float get_surface_area() const;
+
+		/*
+		 * Returns whenever both boxes are overlapping, touching
+		 * boxes are considered overlapping.
+		 */
+		bool intersects( const Box& other ) const;
+		/*
+		 * Returns whenever the given box is fully inside this box.
+		 */
+		bool contains( const Box& other ) const;
+
+		/*
+		 * Returns a copy of the box grown by the given margin on all axes.
+		 */
+		Box expanded( float margin ) const;
+
+		/*
+		 * Returns the smallest box enclosing both given boxes.
+		 */
+		static Box merge( const Box& a, const Box& b );
 
 	public:
 		Box operator+( const Vec3& pos ) const
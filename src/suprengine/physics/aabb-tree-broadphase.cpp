@@ -0,0 +1,352 @@
+#include "aabb-tree-broadphase.h"
+
+#include <suprengine/components/collider.h>
+
+#include <suprengine/math/math.h>
+
+#include <suprengine/utils/assert.h>
+
+using namespace suprengine;
+
+void AABBTreeBroadphase::add_collider( Collider* collider )
+{
+	const int leaf_id = _allocate_node();
+
+	Node& leaf = _nodes[leaf_id];
+	leaf.box = collider->get_bounds().expanded( margin );
+	leaf.collider = collider;
+	leaf.height = 0;
+
+	collider->broadphase_proxy_id = leaf_id;
+	_insert_leaf( leaf_id );
+}
+
+void AABBTreeBroadphase::remove_collider( Collider* collider )
+{
+	const int leaf_id = collider->broadphase_proxy_id;
+	if ( leaf_id == INDEX_NONE ) return;
+
+	_remove_leaf( leaf_id );
+	_free_node( leaf_id );
+
+	collider->broadphase_proxy_id = INDEX_NONE;
+}
+
+void AABBTreeBroadphase::update_collider( Collider* collider )
+{
+	const int leaf_id = collider->broadphase_proxy_id;
+	ASSERT( leaf_id != INDEX_NONE );
+
+	//	Fat bounds still enclose the collider, nothing to do
+	const Box& bounds = collider->get_bounds();
+	if ( _nodes[leaf_id].box.contains( bounds ) ) return;
+
+	//	Re-insert with new bounds
+	_remove_leaf( leaf_id );
+	_nodes[leaf_id].box = bounds.expanded( margin );
+	_insert_leaf( leaf_id );
+}
+
+void AABBTreeBroadphase::compute_pairs( std::vector<ColliderPair>& pairs )
+{
+	if ( _root == INDEX_NONE ) return;
+
+	for ( int leaf_id = 0; leaf_id < static_cast<int>( _nodes.size() ); leaf_id++ )
+	{
+		const Node& leaf = _nodes[leaf_id];
+		if ( leaf.height != 0 ) continue;
+
+		const Box& bounds = leaf.collider->get_bounds();
+
+		//	Query the tree with the leaf bounds
+		_query_stack.clear();
+		_query_stack.push_back( _root );
+		while ( !_query_stack.empty() )
+		{
+			const int node_id = _query_stack.back();
+			_query_stack.pop_back();
+
+			const Node& node = _nodes[node_id];
+			if ( !node.box.intersects( bounds ) ) continue;
+
+			if ( node.is_leaf() )
+			{
+				//	Only report each pair once, from the leaf with the lowest identifier
+				if ( node_id <= leaf_id ) continue;
+				if ( !node.collider->get_bounds().intersects( bounds ) ) continue;
+
+				pairs.emplace_back( leaf.collider, node.collider );
+				continue;
+			}
+
+			_query_stack.push_back( node.left );
+			_query_stack.push_back( node.right );
+		}
+	}
+}
+
+int AABBTreeBroadphase::get_height() const
+{
+	if ( _root == INDEX_NONE ) return 0;
+	return _nodes[_root].height;
+}
+
+int AABBTreeBroadphase::_allocate_node()
+{
+	//	Grow the pool when there are no free nodes left
+	if ( _free_list == INDEX_NONE )
+	{
+		_nodes.emplace_back();
+		return static_cast<int>( _nodes.size() ) - 1;
+	}
+
+	const int node_id = _free_list;
+	_free_list = _nodes[node_id].parent;
+	_nodes[node_id] = Node {};
+	return node_id;
+}
+
+void AABBTreeBroadphase::_free_node( const int node_id )
+{
+	Node& node = _nodes[node_id];
+	node = Node {};
+	node.parent = _free_list;
+	_free_list = node_id;
+}
+
+void AABBTreeBroadphase::_insert_leaf( const int leaf_id )
+{
+	if ( _root == INDEX_NONE )
+	{
+		_root = leaf_id;
+		_nodes[_root].parent = INDEX_NONE;
+		return;
+	}
+
+	//	Find the best sibling using the surface area heuristic
+	const Box leaf_box = _nodes[leaf_id].box;
+	int sibling_id = _root;
+	while ( !_nodes[sibling_id].is_leaf() )
+	{
+		const Node& node = _nodes[sibling_id];
+
+		const float area = node.box.get_surface_area();
+		const float combined_area = Box::merge( node.box, leaf_box ).get_surface_area();
+
+		//	Cost of creating a new parent for this node and the new leaf
+		const float cost = 2.0f * combined_area;
+		//	Minimum cost of pushing the leaf further down the tree
+		const float inheritance_cost = 2.0f * ( combined_area - area );
+
+		auto get_descend_cost = [&]( const int child_id )
+		{
+			const Node& child = _nodes[child_id];
+			const float merged_area = Box::merge( child.box, leaf_box ).get_surface_area();
+			if ( child.is_leaf() ) return merged_area + inheritance_cost;
+
+			return merged_area - child.box.get_surface_area() + inheritance_cost;
+		};
+		const float left_cost = get_descend_cost( node.left );
+		const float right_cost = get_descend_cost( node.right );
+
+		if ( cost < left_cost && cost < right_cost ) break;
+
+		sibling_id = left_cost < right_cost ? node.left : node.right;
+	}
+
+	//	Create a new parent for both the sibling and the leaf
+	//	NOTE: Allocating may invalidate references to nodes.
+	const int old_parent_id = _nodes[sibling_id].parent;
+	const int new_parent_id = _allocate_node();
+	{
+		Node& new_parent = _nodes[new_parent_id];
+		new_parent.parent = old_parent_id;
+		new_parent.box = Box::merge( leaf_box, _nodes[sibling_id].box );
+		new_parent.height = _nodes[sibling_id].height + 1;
+		new_parent.left = sibling_id;
+		new_parent.right = leaf_id;
+	}
+
+	if ( old_parent_id != INDEX_NONE )
+	{
+		Node& old_parent = _nodes[old_parent_id];
+		if ( old_parent.left == sibling_id )
+		{
+			old_parent.left = new_parent_id;
+		}
+		else
+		{
+			old_parent.right = new_parent_id;
+		}
+	}
+	else
+	{
+		_root = new_parent_id;
+	}
+	_nodes[sibling_id].parent = new_parent_id;
+	_nodes[leaf_id].parent = new_parent_id;
+
+	_refit_ancestors( new_parent_id );
+}
+
+void AABBTreeBroadphase::_remove_leaf( const int leaf_id )
+{
+	if ( leaf_id == _root )
+	{
+		_root = INDEX_NONE;
+		return;
+	}
+
+	const int parent_id = _nodes[leaf_id].parent;
+	const int grand_parent_id = _nodes[parent_id].parent;
+	const int sibling_id = _nodes[parent_id].left == leaf_id
+		? _nodes[parent_id].right
+		: _nodes[parent_id].left;
+
+	//	Replace the parent by the sibling
+	_nodes[sibling_id].parent = grand_parent_id;
+	_free_node( parent_id );
+
+	if ( grand_parent_id == INDEX_NONE )
+	{
+		_root = sibling_id;
+		return;
+	}
+
+	Node& grand_parent = _nodes[grand_parent_id];
+	if ( grand_parent.left == parent_id )
+	{
+		grand_parent.left = sibling_id;
+	}
+	else
+	{
+		grand_parent.right = sibling_id;
+	}
+
+	_refit_ancestors( grand_parent_id );
+}
+
+void AABBTreeBroadphase::_refit_ancestors( int node_id )
+{
+	while ( node_id != INDEX_NONE )
+	{
+		node_id = _balance( node_id );
+
+		Node& node = _nodes[node_id];
+		const Node& left = _nodes[node.left];
+		const Node& right = _nodes[node.right];
+		node.box = Box::merge( left.box, right.box );
+		node.height = 1 + math::max( left.height, right.height );
+
+		node_id = node.parent;
+	}
+}
+
+int AABBTreeBroadphase::_balance( const int a_id )
+{
+	Node& a = _nodes[a_id];
+	if ( a.is_leaf() || a.height < 2 ) return a_id;
+
+	const int b_id = a.left;
+	const int c_id = a.right;
+	Node& b = _nodes[b_id];
+	Node& c = _nodes[c_id];
+
+	//	Replace the parent's link to A by the given node
+	auto replace_in_parent = [&]( const int new_id, const int parent_id )
+	{
+		if ( parent_id == INDEX_NONE )
+		{
+			_root = new_id;
+			return;
+		}
+
+		Node& parent = _nodes[parent_id];
+		if ( parent.left == a_id )
+		{
+			parent.left = new_id;
+		}
+		else
+		{
+			parent.right = new_id;
+		}
+	};
+
+	const int balance = c.height - b.height;
+
+	//	Rotate C up
+	if ( balance > 1 )
+	{
+		const int f_id = c.left;
+		const int g_id = c.right;
+		Node& f = _nodes[f_id];
+		Node& g = _nodes[g_id];
+
+		c.left = a_id;
+		c.parent = a.parent;
+		a.parent = c_id;
+		replace_in_parent( c_id, c.parent );
+
+		if ( f.height > g.height )
+		{
+			c.right = f_id;
+			a.right = g_id;
+			g.parent = a_id;
+			a.box = Box::merge( b.box, g.box );
+			c.box = Box::merge( a.box, f.box );
+			a.height = 1 + math::max( b.height, g.height );
+			c.height = 1 + math::max( a.height, f.height );
+		}
+		else
+		{
+			c.right = g_id;
+			a.right = f_id;
+			f.parent = a_id;
+			a.box = Box::merge( b.box, f.box );
+			c.box = Box::merge( a.box, g.box );
+			a.height = 1 + math::max( b.height, f.height );
+			c.height = 1 + math::max( a.height, g.height );
+		}
+
+		return c_id;
+	}
+
+	//	Rotate B up
+	if ( balance < -1 )
+	{
+		const int d_id = b.left;
+		const int e_id = b.right;
+		Node& d = _nodes[d_id];
+		Node& e = _nodes[e_id];
+
+		b.left = a_id;
+		b.parent = a.parent;
+		a.parent = b_id;
+		replace_in_parent( b_id, b.parent );
+
+		if ( d.height > e.height )
+		{
+			b.right = d_id;
+			a.left = e_id;
+			e.parent = a_id;
+			a.box = Box::merge( c.box, e.box );
+			b.box = Box::merge( a.box, d.box );
+			a.height = 1 + math::max( c.height, e.height );
+			b.height = 1 + math::max( a.height, d.height );
+		}
+		else
+		{
+			b.right = e_id;
+			a.left = d_id;
+			d.parent = a_id;
+			a.box = Box::merge( c.box, d.box );
+			b.box = Box::merge( a.box, e.box );
+			a.height = 1 + math::max( c.height, d.height );
+			b.height = 1 + math::max( a.height, e.height );
+		}
+
+		return b_id;
+	}
+
+	return a_id;
+}
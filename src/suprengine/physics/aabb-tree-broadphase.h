@@ -0,0 +1,90 @@
+#pragma once
+
+#include <suprengine/physics/broadphase.h>
+
+#include <suprengine/math/box.h>
+
+#include <suprengine/utils/usings.h>
+
+namespace suprengine
+{
+	/*
+	 * Broadphase storing the colliders bounds inside a dynamic bounding 
+	 * volume hierarchy, inspired by Box2D's b2DynamicTree.
+	 * 
+	 * Leaves store "fat" bounds, grown by a margin, so that small movements
+	 * don't require any tree update. The tree is kept balanced through
+	 * rotations, allowing logarithmic queries on each collider.
+	 */
+	class AABBTreeBroadphase : public Broadphase
+	{
+	public:
+		void add_collider( Collider* collider ) override;
+		void remove_collider( Collider* collider ) override;
+		void update_collider( Collider* collider ) override;
+
+		void compute_pairs( std::vector<ColliderPair>& pairs ) override;
+
+		const char* get_name() const override { return "AABB Tree"; }
+
+		/*
+		 * Returns the height of the tree, mainly for debugging purposes.
+		 */
+		int get_height() const;
+
+	public:
+		/*
+		 * Margin added to the leaves bounds.
+		 * Higher values reduce tree updates of moving colliders but
+		 * increase the amount of pairs to test.
+		 */
+		float margin = 0.2f;
+
+	private:
+		struct Node
+		{
+			Box box {};
+			Collider* collider = nullptr;
+
+			/*
+			 * Parent node, or next free node when not allocated.
+			 */
+			int parent = INDEX_NONE;
+			int left = INDEX_NONE;
+			int right = INDEX_NONE;
+
+			/*
+			 * Height of the node in the tree, a leaf being 0 and
+			 * a free node being -1.
+			 */
+			int height = INDEX_NONE;
+
+			bool is_leaf() const { return left == INDEX_NONE; }
+		};
+
+	private:
+		int _allocate_node();
+		void _free_node( int node_id );
+
+		void _insert_leaf( int leaf_id );
+		void _remove_leaf( int leaf_id );
+
+		/*
+		 * Fix bounds and heights of the given node ancestors,
+		 * balancing the tree along the way.
+		 */
+		void _refit_ancestors( int node_id );
+		/*
+		 * Perform a left or right rotation if the given node is 
+		 * imbalanced. Returns the new root node of this sub-tree.
+		 */
+		int _balance( int node_id );
+
+	private:
+		std::vector<Node> _nodes {};
+		int _root = INDEX_NONE;
+		int _free_list = INDEX_NONE;
+
+		std::vector<int> _query_stack {};
+	};
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+namespace suprengine
+{
+	class Collider;
+
+	/*
+	 * Pair of colliders whose bounds are overlapping, as found by a broadphase.
+	 */
+	struct ColliderPair
+	{
+		Collider* first = nullptr;
+		Collider* second = nullptr;
+	};
+
+	/*
+	 * Interface of the collision detection first stage.
+	 * 
+	 * A broadphase cheaply finds which colliders may be colliding by
+	 * testing their cached world-space bounds, so that the expensive
+	 * narrowphase (i.e. Collider::intersects) only runs on these pairs.
+	 */
+	class Broadphase
+	{
+	public:
+		virtual ~Broadphase() {}
+
+		virtual void add_collider( Collider* collider ) = 0;
+		virtual void remove_collider( Collider* collider ) = 0;
+		/*
+		 * Called by the physics once the bounds of an active collider
+		 * have been refreshed for this update.
+		 */
+		virtual void update_collider( Collider* ) {}
+
+		/*
+		 * Find all pairs of colliders with overlapping bounds. 
+		 * Each pair is reported once in an unspecified order and
+		 * appended to the given vector.
+		 */
+		virtual void compute_pairs( std::vector<ColliderPair>& pairs ) = 0;
+
+		virtual const char* get_name() const = 0;
+	};
+}
@@ -0,0 +1,81 @@
+#include "sweep-and-prune-broadphase.h"
+
+#include <suprengine/components/collider.h>
+
+#include <algorithm>
+
+using namespace suprengine;
+
+void SweepAndPruneBroadphase::add_collider( Collider* collider )
+{
+	const Box& bounds = collider->get_bounds();
+	_proxies.emplace_back( collider, bounds.min.x, bounds.max.x );
+}
+
+void SweepAndPruneBroadphase::remove_collider( Collider* collider )
+{
+	const auto itr = std::find_if(
+		_proxies.begin(), _proxies.end(),
+		[collider]( const Proxy& proxy ) { return proxy.collider == collider; }
+	);
+	if ( itr == _proxies.end() ) return;
+
+	_proxies.erase( itr );  //  Don't swap to keep the order for the next sort
+}
+
+void SweepAndPruneBroadphase::compute_pairs( std::vector<ColliderPair>& pairs )
+{
+	//	Refresh proxies from the cached bounds
+	for ( Proxy& proxy : _proxies )
+	{
+		const Box& bounds = proxy.collider->get_bounds();
+		proxy.min_x = bounds.min.x;
+		proxy.max_x = bounds.max.x;
+	}
+
+	//	Insertion sort along X-axis, proxies are expected to be nearly sorted
+	//	from the previous update
+	for ( int i = 1; i < static_cast<int>( _proxies.size() ); i++ )
+	{
+		const Proxy proxy = _proxies[i];
+
+		int j = i - 1;
+		for ( ; j >= 0 && _proxies[j].min_x > proxy.min_x; j-- )
+		{
+			_proxies[j + 1] = _proxies[j];
+		}
+		_proxies[j + 1] = proxy;
+	}
+
+	//	Sweep through the proxies while keeping the ones whose interval
+	//	on X-axis is still open
+	_active_proxies.clear();
+	for ( int i = 0; i < static_cast<int>( _proxies.size() ); i++ )
+	{
+		const Proxy& proxy = _proxies[i];
+		const Box& bounds = proxy.collider->get_bounds();
+
+		for ( int active_id = 0; active_id < static_cast<int>( _active_proxies.size() ); )
+		{
+			const Proxy& other = _proxies[_active_proxies[active_id]];
+
+			//	Prune proxies ending before the current one starts
+			if ( other.max_x < proxy.min_x )
+			{
+				_active_proxies[active_id] = _active_proxies.back();
+				_active_proxies.pop_back();
+				continue;
+			}
+
+			//	Overlapping on X-axis, check the remaining axes
+			if ( bounds.intersects( other.collider->get_bounds() ) )
+			{
+				pairs.emplace_back( other.collider, proxy.collider );
+			}
+
+			active_id++;
+		}
+
+		_active_proxies.push_back( i );
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <suprengine/physics/broadphase.h>
+
+namespace suprengine
+{
+	/*
+	 * Broadphase sorting the colliders bounds along the X-axis and 
+	 * sweeping through them to only test neighbours for overlaps.
+	 * 
+	 * Since colliders barely move between two updates, the order is
+	 * kept across updates and re-sorted with an insertion sort, which
+	 * runs in near-linear time on nearly sorted data.
+	 */
+	class SweepAndPruneBroadphase : public Broadphase
+	{
+	public:
+		void add_collider( Collider* collider ) override;
+		void remove_collider( Collider* collider ) override;
+
+		void compute_pairs( std::vector<ColliderPair>& pairs ) override;
+
+		const char* get_name() const override { return "Sweep And Prune"; }
+
+	private:
+		struct Proxy
+		{
+			Collider* collider = nullptr;
+			float min_x = 0.0f;
+			float max_x = 0.0f;
+		};
+
+	private:
+		std::vector<Proxy> _proxies {};
+		std::vector<int> _active_proxies {};
+	};
+}
@@ -0,0 +1,215 @@
+#include "null-render-batch.h"
+
+#include <suprengine/core/assets.h>
+
+#include <suprengine/rendering/texture.h>
+
+#include <suprengine/utils/assert.h>
+#include <suprengine/utils/logger.h>
+
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+
+using namespace suprengine;
+
+NullRenderBatch::NullRenderBatch( Window* window )
+	: RenderBatch( window )
+{
+	//  Initialize SDL's IMG library, still required to load textures
+	const int img_status = IMG_Init( IMG_INIT_PNG );
+	ASSERT_MSG( img_status != 0, IMG_GetError() );
+	Logger::info( "Initialized SDL Image library" );
+
+	//  Initialize SDL's TTF library
+	const int ttf_status = TTF_Init();
+	ASSERT_MSG( ttf_status == 0, TTF_GetError() );
+	Logger::info( "Initialized SDL TTF library" );
+}
+
+NullRenderBatch::~NullRenderBatch()
+{
+	IMG_Quit();
+	TTF_Quit();
+}
+
+void NullRenderBatch::init()
+{
+	RenderBatch::init();
+
+	_load_assets();
+}
+
+bool NullRenderBatch::init_imgui()
+{
+	return true;
+}
+
+void NullRenderBatch::begin_imgui_frame()
+{}
+
+void NullRenderBatch::begin_render()
+{
+	_current_stats = {};
+}
+
+void NullRenderBatch::render( const SharedPtr<Camera> camera )
+{
+	_camera = camera;
+	_current_stats.cameras_count++;
+}
+
+void NullRenderBatch::end_render()
+{
+	_camera = nullptr;
+
+	_frame_stats = _current_stats;
+	_frames_count++;
+}
+
+SharedPtr<Camera> NullRenderBatch::get_camera()
+{
+	return _camera;
+}
+
+void NullRenderBatch::on_window_resized( const Vec2& )
+{}
+
+void NullRenderBatch::draw_rect( DrawType, const Rect&, const Color& )
+{
+	_current_stats.rects_count++;
+}
+
+void NullRenderBatch::draw_texture(
+	const Rect&,
+	const Rect&,
+	float,
+	const Vec2&,
+	SharedPtr<Texture>,
+	const Color&
+)
+{
+	_current_stats.textures_count++;
+}
+
+void NullRenderBatch::draw_texture(
+	const Mtx4&,
+	SharedPtr<Texture>,
+	const Vec2&,
+	const Rect&,
+	const Color&
+)
+{
+	_current_stats.textures_count++;
+}
+
+void NullRenderBatch::draw_mesh(
+	const Mtx4&,
+	const Mesh*,
+	SharedPtr<ShaderProgram>,
+	SharedPtr<Texture>,
+	const Color&
+)
+{
+	_current_stats.meshes_count++;
+}
+
+void NullRenderBatch::draw_mesh(
+	const Mtx4&,
+	Mesh*,
+	int,
+	const Color&
+)
+{
+	_current_stats.meshes_count++;
+}
+
+void NullRenderBatch::draw_model(
+	const Mtx4&,
+	const SharedPtr<Model>&,
+	rconst_str,
+	const Color&
+)
+{
+	_current_stats.models_count++;
+}
+
+void NullRenderBatch::draw_debug_model(
+	const Mtx4&,
+	const SharedPtr<Model>&,
+	const Color&
+)
+{
+	_current_stats.models_count++;
+}
+
+void NullRenderBatch::draw_line( const Vec3&, const Vec3&, const Color& )
+{
+	_current_stats.lines_count++;
+}
+
+void NullRenderBatch::translate( const Vec2& )
+{}
+
+void NullRenderBatch::scale( float )
+{}
+
+void NullRenderBatch::clip( const Rect& )
+{}
+
+bool NullRenderBatch::set_vsync( const VSyncMode mode )
+{
+	return mode == VSyncMode::Disabled;
+}
+
+VSyncMode NullRenderBatch::get_vsync_mode()
+{
+	return VSyncMode::Disabled;
+}
+
+SharedPtr<Texture> NullRenderBatch::load_texture_from_surface(
+	rconst_str path,
+	SDL_Surface* surface,
+	const TextureParams&
+)
+{
+	const Vec2 size {
+		static_cast<float>( surface->w ),
+		static_cast<float>( surface->h )
+	};
+	return std::make_shared<Texture>( path, size );
+}
+
+void NullRenderBatch::_load_assets()
+{
+	Logger::info( "RenderBatch: Loading engine assets" );
+
+	//	Load textures
+	Assets::load_texture(
+		TEXTURE_LARGE_GRID,
+		"assets/suprengine/textures/large-grid.png"
+	);
+	Assets::load_texture(
+		TEXTURE_MEDIUM_GRID,
+		"assets/suprengine/textures/medium-grid.png"
+	);
+	SharedPtr<Texture> texture = Assets::load_texture(
+		TEXTURE_WHITE,
+		"assets/suprengine/textures/white.png"
+	);
+
+	//	Load models, without their vertex arrays
+	const char* const models[][2] {
+		{ MESH_ARROW, "assets/suprengine/models/arrow.fbx" },
+		{ MESH_CUBE, "assets/suprengine/models/cube.fbx" },
+		{ MESH_CYLINDER, "assets/suprengine/models/cylinder.fbx" },
+		{ MESH_SPHERE, "assets/suprengine/models/sphere.fbx" },
+		{ MESH_PLANE, "assets/suprengine/models/plane.fbx" },
+	};
+	for ( const auto& [name, path] : models )
+	{
+		SharedPtr<Model> model = Assets::load_model( name, path, SHADER_LIT_MESH );
+		if ( model == nullptr ) continue;
+
+		model->get_mesh( 0 )->add_texture( texture );
+	}
+}
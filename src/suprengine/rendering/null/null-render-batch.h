@@ -0,0 +1,131 @@
+#pragma once
+
+#include <suprengine/core/render-batch.h>
+
+namespace suprengine
+{
+	/*
+	 * Amount of calls recorded by a NullRenderBatch during a frame.
+	 */
+	struct NullRenderStats
+	{
+		int cameras_count = 0;
+		int rects_count = 0;
+		int textures_count = 0;
+		int meshes_count = 0;
+		int models_count = 0;
+		int lines_count = 0;
+	};
+
+	/*
+	 * Render batch without any graphics backend, used by the engine
+	 * when running headless.
+	 *
+	 * Draw calls only are recorded, renderers aren't rendered and
+	 * textures are loaded without being uploaded to a GPU.
+	 */
+	class NullRenderBatch : public RenderBatch
+	{
+	public:
+		NullRenderBatch( Window* window );
+		NullRenderBatch( const NullRenderBatch& ) = delete;
+		NullRenderBatch& operator=( const NullRenderBatch& ) = delete;
+		~NullRenderBatch();
+
+		void init() override;
+		bool init_imgui() override;
+		void begin_imgui_frame() override;
+
+		void begin_render() override;
+		void render( SharedPtr<Camera> camera ) override;
+		void end_render() override;
+
+		SharedPtr<Camera> get_camera() override;
+
+		void on_window_resized( const Vec2& size ) override;
+
+		void draw_rect( 
+			DrawType draw_type, 
+			const Rect& rect, 
+			const Color& color 
+		) override;
+
+		void draw_texture(
+			const Rect& src_rect, 
+			const Rect& dest_rect, 
+			float rotation, 
+			const Vec2& origin,
+			SharedPtr<Texture> texture, 
+			const Color& color 
+		) override;
+		void draw_texture(
+			const Mtx4& matrix,
+			SharedPtr<Texture> texture, 
+			const Vec2& origin,
+			const Rect& src_rect, 
+			const Color& color = Color::white
+		) override;
+
+		void draw_mesh(
+			const Mtx4& matrix,
+			const Mesh* mesh,
+			SharedPtr<ShaderProgram> shader,
+			SharedPtr<Texture> texture,
+			const Color& color = Color::white
+		) override;
+		void draw_mesh( 
+			const Mtx4& matrix,
+			Mesh* mesh, 
+			int texture_id, 
+			const Color& color = Color::white
+		) override;
+		void draw_model( 
+			const Mtx4& matrix, 
+			const SharedPtr<Model>& model,
+			rconst_str shader_program_name,
+			const Color& color = Color::white
+		) override;
+		void draw_debug_model( 
+			const Mtx4& matrix, 
+			const SharedPtr<Model>& model, 
+			const Color& color 
+		) override;
+
+		void draw_line(
+			const Vec3& start,
+			const Vec3& end,
+			const Color& color = Color::white
+		) override;
+
+		void translate( const Vec2& pos ) override;
+		void scale( float zoom ) override;
+		void clip( const Rect& region ) override;
+
+		bool set_vsync( VSyncMode mode ) override;
+		VSyncMode get_vsync_mode() override;
+
+		SharedPtr<Texture> load_texture_from_surface(
+			rconst_str path,
+			SDL_Surface* surface,
+			const TextureParams& params = {}
+		) override;
+
+		bool is_headless() const override { return true; }
+
+		/*
+		 * Returns the calls recorded during the last rendered frame.
+		 */
+		NullRenderStats get_frame_stats() const { return _frame_stats; }
+		int get_frames_count() const { return _frames_count; }
+
+	private:
+		void _load_assets();
+
+	private:
+		SharedPtr<Camera> _camera = nullptr;
+
+		NullRenderStats _current_stats {};
+		NullRenderStats _frame_stats {};
+		int _frames_count = 0;
+	};
+}
@@ -108,28 +108,28 @@ bool ShaderProgram::prepare( const uint32 frame_tick )
 	return true;
 }
 
-void ShaderProgram::set_float( const char* name, const float value )
+void ShaderProgram::set_float( const StringId name, const float value )
 {
 	glUniform1f( get_uniform_location( name ), value );
 }
 
-void ShaderProgram::set_int( const char* name, const int value )
+void ShaderProgram::set_int( const StringId name, const int value )
 {
 	glUniform1i( get_uniform_location( name ), value );
 }
 
-void ShaderProgram::set_vec2( const char* name, const Vec2& value )
+void ShaderProgram::set_vec2( const StringId name, const Vec2& value )
 {
 	glUniform2f( get_uniform_location( name ), value.x, value.y );
 }
 
-void ShaderProgram::set_vec3( const char* name, const Vec3& value )
+void ShaderProgram::set_vec3( const StringId name, const Vec3& value )
 {
 	glUniform3f( get_uniform_location( name ), value.x, value.y, value.z );
 }
 
 void ShaderProgram::set_vec4(
-	const char* name,
+	const StringId name,
 	const float x,
 	const float y,
 	const float z,
@@ -139,7 +139,7 @@ void ShaderProgram::set_vec4(
 	glUniform4f( get_uniform_location( name ), x, y, z, w );
 }
 
-void ShaderProgram::set_color( const char* name, const Color& value )
+void ShaderProgram::set_color( const StringId name, const Color& value )
 {
 	set_vec4(
 		name,
@@ -150,7 +150,7 @@ void ShaderProgram::set_color( const char* name, const Color& value )
 	);
 }
 
-void ShaderProgram::set_mtx4( const char* name, const Mtx4& matrix )
+void ShaderProgram::set_mtx4( const StringId name, const Mtx4& matrix )
 {
 	glUniformMatrix4fv( get_uniform_location( name ), 1, GL_TRUE, &matrix[0][0] );
 }
@@ -243,7 +243,7 @@ void ShaderProgram::print_all_params() const
 	}
 }
 
-uint32 ShaderProgram::get_uniform_location( const char* name ) const
+uint32 ShaderProgram::get_uniform_location( const StringId name ) const
 {
 	PROFILE_SCOPE( "ShaderProgram::get_uniform_location" );
 
@@ -341,13 +341,13 @@ void ShaderProgram::update_uniform_locations()
 				std::snprintf( long_name, MAX_ARRAY_NAME_LENGTH, "%s[%d]", name, j );
 
 				const GLint location = glGetUniformLocation( _id, long_name );
-				_uniform_locations.emplace( long_name, location );
+				_uniform_locations.emplace( StringId::intern( long_name ), location );
 			}
 		}
 		else
 		{
 			const int location = glGetUniformLocation( _id, name );
-			_uniform_locations.emplace( name, location );
+			_uniform_locations.emplace( StringId::intern( name ), location );
 		}
 	}
 }
\ No newline at end of file
@@ -1,8 +1,9 @@
 ﻿#pragma once
 
 #include <vector>
-#include <unordered_map>
 
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/string-id.h>
 #include <suprengine/utils/usings.h>
 
 namespace suprengine
@@ -53,19 +54,19 @@ namespace suprengine
 		 */
     	bool prepare( uint32 frame_tick );
 
-    	void set_float( const char* name, float value );
-    	void set_int( const char* name, int value );
+    	void set_float( StringId name, float value );
+    	void set_int( StringId name, int value );
 
-    	void set_vec2( const char* name, const Vec2& value );
-    	void set_vec3( const char* name, const Vec3& value );
-    	void set_vec4( const char* name, float x, float y, float z, float w );
+    	void set_vec2( StringId name, const Vec2& value );
+    	void set_vec3( StringId name, const Vec3& value );
+    	void set_vec4( StringId name, float x, float y, float z, float w );
 
-    	void set_color( const char* name, const Color& value );
-    	void set_mtx4( const char* name, const Mtx4& matrix );
+    	void set_color( StringId name, const Color& value );
+    	void set_mtx4( StringId name, const Mtx4& matrix );
 
 		void print_all_params() const;
 
-		uint32 get_uniform_location( const char* name ) const;
+		uint32 get_uniform_location( StringId name ) const;
 
 		/**
 		 * Returns whether the program is ready-for-use (i.e. linked and validated).
@@ -88,7 +89,7 @@ namespace suprengine
 		void update_uniform_locations();
 
 	private:
-		using UniformsLocationsMap = std::unordered_map<std::string, int>;
+		using UniformsLocationsMap = FlatHashMap<StringId, int>;
 
 	private:
 		std::string _name {};
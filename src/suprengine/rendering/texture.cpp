@@ -92,6 +92,9 @@ Texture::Texture( rconst_str path, SDL_Surface* surface, const TextureParams& pa
 
 Texture::~Texture()
 {
+	//  Textures created without a surface aren't uploaded to OpenGL
+	if ( texture_id == 0 ) return;
+
 	glDeleteTextures( 1, &texture_id );
 }
 
@@ -0,0 +1,211 @@
+#include "benchmark-report.h"
+
+#include <suprengine/core/engine.h>
+
+#include <suprengine/tools/memory-profiler.h>
+#include <suprengine/tools/profiler.h>
+
+#include <suprengine/utils/json.h>
+#include <suprengine/utils/logger.h>
+
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace suprengine;
+
+using JsonWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+/*
+ * Returns the nearest-rank percentile of sorted values.
+ */
+static float get_percentile( const std::vector<float>& sorted_values, const float percentile )
+{
+	if ( sorted_values.empty() ) return 0.0f;
+
+	const int count = static_cast<int>( sorted_values.size() );
+	const int index = static_cast<int>( math::ceil( count * percentile ) ) - 1;
+	return sorted_values[math::clamp( index, 0, count - 1 )];
+}
+
+BenchmarkReport::BenchmarkReport( const int frames_count, const float delta_time )
+	: _frames_count( frames_count ), _delta_time( delta_time )
+{
+	_frame_times.reserve( frames_count );
+}
+
+void BenchmarkReport::start()
+{
+	_frame_times.clear();
+
+	//  Only profile the benchmarked frames
+	Profiler* profiler = Engine::instance().get_profiler();
+	profiler->clear();
+	profiler->start();
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::update();
+	const MemoryGlobalProfileResult& memory_result = MemoryProfiler::get_global_result();
+	_start_allocations_count = memory_result.total_instances;
+	_start_deallocations_count = memory_result.delete_total_calls;
+	_start_allocated_bytes = memory_result.total_allocated_bytes;
+#endif
+}
+
+void BenchmarkReport::add_frame_time( const float time )
+{
+	_frame_times.push_back( time );
+}
+
+bool BenchmarkReport::is_finished() const
+{
+	return static_cast<int>( _frame_times.size() ) >= _frames_count;
+}
+
+BenchmarkFrameTimes BenchmarkReport::compute_frame_times() const
+{
+	BenchmarkFrameTimes frame_times {};
+	if ( _frame_times.empty() ) return frame_times;
+
+	std::vector<float> sorted_times = _frame_times;
+	std::sort( sorted_times.begin(), sorted_times.end() );
+
+	for ( const float time : sorted_times )
+	{
+		frame_times.total += time;
+	}
+
+	frame_times.min = sorted_times.front();
+	frame_times.average = frame_times.total / sorted_times.size();
+	frame_times.max = sorted_times.back();
+	frame_times.p50 = get_percentile( sorted_times, 0.50f );
+	frame_times.p90 = get_percentile( sorted_times, 0.90f );
+	frame_times.p95 = get_percentile( sorted_times, 0.95f );
+	frame_times.p99 = get_percentile( sorted_times, 0.99f );
+	return frame_times;
+}
+
+bool BenchmarkReport::write( rconst_str path ) const
+{
+	Engine& engine = Engine::instance();
+
+	rapidjson::StringBuffer buffer {};
+	JsonWriter writer( buffer );
+
+	writer.StartObject();
+
+	writer.Key( "frames_count" );
+	writer.Int( static_cast<int>( _frame_times.size() ) );
+	writer.Key( "delta_time" );
+	writer.Double( _delta_time );
+
+	//  Frame times
+	const BenchmarkFrameTimes frame_times = compute_frame_times();
+	writer.Key( "frame_times" );
+	writer.StartObject();
+	{
+		const std::pair<const char*, float> values[] {
+			{ "min", frame_times.min },
+			{ "average", frame_times.average },
+			{ "max", frame_times.max },
+			{ "p50", frame_times.p50 },
+			{ "p90", frame_times.p90 },
+			{ "p95", frame_times.p95 },
+			{ "p99", frame_times.p99 },
+			{ "total", frame_times.total },
+		};
+		for ( const auto& [key, value] : values )
+		{
+			writer.Key( key );
+			writer.Double( value );
+		}
+	}
+	writer.EndObject();
+
+	//  Profile scopes
+	writer.Key( "profile_scopes" );
+	writer.StartObject();
+	for ( const ProfileResult& result : engine.get_profiler()->get_results() )
+	{
+		if ( result.total_calls == 0 ) continue;
+
+		writer.Key( result.name );
+		writer.StartObject();
+		writer.Key( "calls" );
+		writer.Uint( result.total_calls );
+		writer.Key( "total_time" );
+		writer.Double( result.total_time );
+		writer.Key( "self_time" );
+		writer.Double( result.total_self_time );
+		writer.Key( "average_time" );
+		writer.Double( result.total_time / result.total_calls );
+		writer.Key( "min_time" );
+		writer.Double( result.min_time );
+		writer.Key( "max_time" );
+		writer.Double( result.max_time );
+
+		//  Percentiles of the last frames only
+		const std::pair<const char*, float> percentiles[] {
+			{ "p50_time", 0.50f },
+			{ "p90_time", 0.90f },
+			{ "p99_time", 0.99f },
+			{ "p99.9_time", 0.999f },
+		};
+		for ( const auto& [key, percentile] : percentiles )
+		{
+			writer.Key( key );
+			writer.Double( result.histogram.get_percentile( percentile ) );
+		}
+		writer.EndObject();
+	}
+	writer.EndObject();
+
+	//  Allocations
+#ifdef ENABLE_MEMORY_PROFILER
+	const MemoryGlobalProfileResult& memory_result = MemoryProfiler::get_global_result();
+	writer.Key( "memory" );
+	writer.StartObject();
+	writer.Key( "allocations_count" );
+	writer.Uint64( memory_result.total_instances - _start_allocations_count );
+	writer.Key( "deallocations_count" );
+	writer.Uint64( memory_result.delete_total_calls - _start_deallocations_count );
+	writer.Key( "allocated_bytes" );
+	writer.Uint64( memory_result.total_allocated_bytes - _start_allocated_bytes );
+	writer.Key( "current_allocated_bytes" );
+	writer.Uint64( memory_result.current_allocated_bytes );
+	writer.EndObject();
+#endif
+
+	//  Engine state
+	const RenderBatch* render_batch = engine.get_render_batch();
+	writer.Key( "entities_count" );
+	writer.Int( engine.get_entities_count() );
+	writer.Key( "ticking_components_count" );
+	writer.Int( engine.get_ticking_components_count() );
+	writer.Key( "colliders_count" );
+	writer.Int( engine.get_physics()->get_colliders_count() );
+	writer.Key( "renderers_count" );
+	writer.Int(
+		render_batch->get_renderers_count( RenderPhase::World )
+		+ render_batch->get_renderers_count( RenderPhase::Viewport )
+	);
+
+	writer.EndObject();
+
+	//  Write to file
+	std::ofstream file( path );
+	if ( !file.is_open() )
+	{
+		Logger::error( "Failed to write benchmark report at path '%s'!", *path );
+		return false;
+	}
+	file << buffer.GetString();
+
+	Logger::info(
+		"Wrote benchmark report of %d frames at path '%s' (avg: %.3fms; p99: %.3fms)",
+		static_cast<int>( _frame_times.size() ), *path,
+		frame_times.average, frame_times.p99
+	);
+	return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Statistics of frame times, in milliseconds.
+	 */
+	struct BenchmarkFrameTimes
+	{
+		float min = 0.0f;
+		float average = 0.0f;
+		float max = 0.0f;
+
+		float p50 = 0.0f;
+		float p90 = 0.0f;
+		float p95 = 0.0f;
+		float p99 = 0.0f;
+
+		float total = 0.0f;
+	};
+
+	/*
+	 * Records the frames of an engine benchmark run and writes a JSON
+	 * report of the engine state once finished.
+	 *
+	 * The report contains the frame times percentiles, the totals of
+	 * each profile scope, the allocation counts of the MemoryProfiler,
+	 * and the amount of entities, colliders and renderers.
+	 */
+	class BenchmarkReport
+	{
+	public:
+		BenchmarkReport( int frames_count, float delta_time );
+
+		/*
+		 * Start recording, baselining the engine profilers.
+		 */
+		void start();
+		void add_frame_time( float time );
+		bool is_finished() const;
+
+		BenchmarkFrameTimes compute_frame_times() const;
+
+		/*
+		 * Write the report at the given path.
+		 * Returns whenever the file could be written.
+		 */
+		bool write( rconst_str path ) const;
+
+	private:
+		int _frames_count = 0;
+		float _delta_time = 0.0f;
+
+		/*
+		 * Recorded frame times in milliseconds.
+		 */
+		std::vector<float> _frame_times {};
+
+		std::size_t _start_allocations_count = 0;
+		std::size_t _start_deallocations_count = 0;
+		std::size_t _start_allocated_bytes = 0;
+	};
+}
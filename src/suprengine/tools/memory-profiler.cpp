@@ -1,24 +1,389 @@
 #ifdef ENABLE_MEMORY_PROFILER
 #include "memory-profiler.h"
 
-#include <suprengine/core/engine.h>
+#include <suprengine/utils/logger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef PLATFORM_WINDOWS
+//	Link DbgHelp library, used to symbolize callstacks
+#ifdef _MSC_VER
+#pragma comment( lib, "dbghelp" )
+#endif
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#undef NOMINMAX
+#undef WIN32_LEAN_AND_MEAN
+
+#include <dbghelp.h>
+#include <malloc.h>
+#elif __has_include( <execinfo.h> )
+#include <execinfo.h>
+#define HAS_EXECINFO
+#endif
+
+#ifdef _MSC_VER
+#define MEMORY_PROFILER_NOINLINE __declspec( noinline )
+#else
+#define MEMORY_PROFILER_NOINLINE __attribute__( ( noinline ) )
+#endif
 
-#include <suprengine/utils/assert.h>
+using namespace suprengine;
 
-#include <vector>
-#include <unordered_map>
+/*
+ * Prefix of each allocation of the global 'new' operator, keeping
+ * the default alignment for the user memory.
+ */
+struct alignas( __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) AllocationHeader
+{
+	std::size_t bytes = 0;
+	/*
+	 * Index of the category, 0 being "Other".
+	 */
+	uint32 category_index = 0;
+};
+
+/*
+ * Counters written only by their owner thread and read by the update,
+ * so relaxed loads and stores are enough.
+ */
+using MemoryCounter = std::atomic<std::size_t>;
+
+static void add_to_counter( MemoryCounter& counter, const std::size_t value )
+{
+	counter.store( counter.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+}
 
-using namespace suprengine;
+static void min_to_counter( MemoryCounter& counter, const std::size_t value )
+{
+	if ( value >= counter.load( std::memory_order_relaxed ) ) return;
+	counter.store( value, std::memory_order_relaxed );
+}
+
+static void max_to_counter( MemoryCounter& counter, const std::size_t value )
+{
+	if ( value <= counter.load( std::memory_order_relaxed ) ) return;
+	counter.store( value, std::memory_order_relaxed );
+}
+
+struct MemoryCategoryCounters
+{
+	MemoryCounter allocations_count { 0 };
+	MemoryCounter deallocations_count { 0 };
+	MemoryCounter allocated_bytes { 0 };
+	MemoryCounter deallocated_bytes { 0 };
+};
+
+struct MemoryLocalCounters
+{
+	MemoryCounter allocations_count { 0 };
+	MemoryCounter deallocations_count { 0 };
+	MemoryCounter allocated_bytes { 0 };
+	MemoryCounter min_bytes { std::numeric_limits<std::size_t>::max() };
+	MemoryCounter max_bytes { 0 };
+
+	MemoryCounter profile_calls { 0 };
+	/*
+	 * Bytes allocated since the last start on this thread, and
+	 * the global order of this start.
+	 */
+	MemoryCounter last_call_bytes { 0 };
+	MemoryCounter last_call_sequence { 0 };
+};
+
+/*
+ * Counters of a thread, allocated on its first allocation and never
+ * released so they can be merged at any time.
+ */
+struct MemoryThreadCounters
+{
+	MemoryCategoryCounters global {};
+	MemoryCounter min_bytes { std::numeric_limits<std::size_t>::max() };
+	MemoryCounter max_bytes { 0 };
+
+	MemoryCategoryCounters categories[MemoryProfiler::MAX_CATEGORIES_COUNT] {};
+	MemoryLocalCounters locals[MemoryProfiler::MAX_LOCAL_SCOPES_COUNT] {};
+
+	/*
+	 * Owner thread only: indices of the started local scopes.
+	 */
+	uint32 active_locals[MemoryProfiler::MAX_ACTIVE_LOCAL_SCOPES_COUNT] {};
+	uint32 active_locals_count = 0;
+
+	/*
+	 * Owner thread only: allocations to skip before the next sample, and
+	 * whenever a sample is being recorded, to ignore its own allocations.
+	 */
+	uint32 allocations_until_sample = 0;
+	bool is_sampling = false;
+
+	MemoryThreadCounters* next = nullptr;
+};
+
+/*
+ * Call site of sampled allocations, identified by its callstack.
+ */
+struct MemoryAllocationSite
+{
+	uint64 hash = 0;
+	void* callstack[MemoryProfiler::MAX_CALLSTACK_DEPTH] {};
+	/*
+	 * Depth of the callstack, 0 for unused sites.
+	 */
+	uint32 depth = 0;
+
+	std::size_t samples_count = 0;
+	std::size_t sampled_bytes = 0;
+
+	uint32 frames_count = 0;
+	uint32 last_frame_index = 0;
+};
+
+/*
+ * Registry of names, only locking to add new ones. Names are published
+ * before the count so they can be read without locking.
+ */
+template <uint32 Capacity>
+struct MemoryNamesRegistry
+{
+	std::mutex mutex {};
+	const char* names[Capacity] {};
+	std::atomic<uint32> count { 0 };
+
+	/*
+	 * Returns the index of the name, registering it if needed.
+	 * Returns Capacity once full.
+	 */
+	uint32 find_or_add( const char* name )
+	{
+		//	Most names are literals, compare their addresses first
+		uint32 current_count = count.load( std::memory_order_acquire );
+		for ( uint32 i = 0; i < current_count; i++ )
+		{
+			if ( names[i] == name ) return i;
+		}
+
+		std::lock_guard lock( mutex );
+
+		//	Match by content, as the same literal may have different addresses
+		current_count = count.load( std::memory_order_relaxed );
+		for ( uint32 i = 0; i < current_count; i++ )
+		{
+			if ( std::strcmp( names[i], name ) == 0 ) return i;
+		}
+		if ( current_count == Capacity ) return Capacity;
+
+		names[current_count] = name;
+		count.store( current_count + 1, std::memory_order_release );
+		return current_count;
+	}
+};
+
+//	NOTE: These are constant-initialized since allocations may happen
+//	before any dynamic initialization.
+static std::atomic<MemoryThreadCounters*> threads_counters { nullptr };
+static thread_local MemoryThreadCounters* current_counters = nullptr;
+static thread_local uint32 current_category_index = 0;
+
+//	The first category is reserved to "Other"
+static MemoryNamesRegistry<MemoryProfiler::MAX_CATEGORIES_COUNT> categories {};
+static MemoryNamesRegistry<MemoryProfiler::MAX_LOCAL_SCOPES_COUNT> local_scopes {};
+static std::atomic<std::size_t> local_calls_sequence { 0 };
+
+//	Call sites are stored in an open addressing table
+static std::atomic<uint32> sites_sampling_rate { 0 };
+static std::mutex sites_mutex {};
+static MemoryAllocationSite sites[MemoryProfiler::MAX_ALLOCATION_SITES_COUNT] {};
+static uint32 tracked_frames_count = 0;
+static std::size_t dropped_samples_count = 0;
 
 static MemoryGlobalProfileResult global_result {};
+static MemoryFrameProfileResult frame_result {};
 static MemoryProfiler::LocalResultsMap local_results {};
-static std::vector<const char*> profiled_names {};
-
-static const char* current_category = nullptr;
 static MemoryCategoryProfileResult other_category_result {};
 static MemoryProfiler::CategoryResultsMap category_results {};
+static MemoryProfiler::ArenaResultsMap arenas_results {};
+
+static MemoryThreadCounters& get_current_counters()
+{
+	if ( current_counters != nullptr ) return *current_counters;
+
+	//	Bypass the 'new' operator to avoid recursion
+	void* memory = std::malloc( sizeof( MemoryThreadCounters ) );
+	if ( memory == nullptr ) throw std::bad_alloc();
+
+	MemoryThreadCounters* counters = new ( memory ) MemoryThreadCounters {};
+	counters->next = threads_counters.load( std::memory_order_relaxed );
+	while ( !threads_counters.compare_exchange_weak( counters->next, counters, std::memory_order_release, std::memory_order_relaxed ) ) {}
+
+	current_counters = counters;
+	return *counters;
+}
+
+static uint32 get_category_index( const char* category )
+{
+	if ( categories.count.load( std::memory_order_relaxed ) == 0 )
+	{
+		categories.find_or_add( "Other" );
+	}
+
+	const uint32 index = categories.find_or_add( category );
+	return index < MemoryProfiler::MAX_CATEGORIES_COUNT ? index : 0;
+}
+
+static void register_allocation_into( MemoryThreadCounters& counters, const uint32 category_index, const std::size_t bytes )
+{
+	//	Register into global result
+	add_to_counter( counters.global.allocations_count, 1 );
+	add_to_counter( counters.global.allocated_bytes, bytes );
+	min_to_counter( counters.min_bytes, bytes );
+	max_to_counter( counters.max_bytes, bytes );
+
+	//	Register into category result
+	MemoryCategoryCounters& category = counters.categories[category_index];
+	add_to_counter( category.allocations_count, 1 );
+	add_to_counter( category.allocated_bytes, bytes );
+
+	//	Register into local results
+	for ( uint32 i = 0; i < counters.active_locals_count; i++ )
+	{
+		MemoryLocalCounters& local = counters.locals[counters.active_locals[i]];
+		add_to_counter( local.allocations_count, 1 );
+		add_to_counter( local.allocated_bytes, bytes );
+		add_to_counter( local.last_call_bytes, bytes );
+		min_to_counter( local.min_bytes, bytes );
+		max_to_counter( local.max_bytes, bytes );
+	}
+}
+
+static void register_deallocation_into( MemoryThreadCounters& counters, const uint32 category_index, const std::size_t bytes )
+{
+	//	Register into global result
+	add_to_counter( counters.global.deallocations_count, 1 );
+	add_to_counter( counters.global.deallocated_bytes, bytes );
+
+	//	Register into category result
+	MemoryCategoryCounters& category = counters.categories[category_index];
+	add_to_counter( category.deallocations_count, 1 );
+	add_to_counter( category.deallocated_bytes, bytes );
+
+	//	Register into local results
+	for ( uint32 i = 0; i < counters.active_locals_count; i++ )
+	{
+		add_to_counter( counters.locals[counters.active_locals[i]].deallocations_count, 1 );
+	}
+}
+
+/*
+ * Returns whenever the current allocation must be sampled.
+ */
+static bool should_sample( MemoryThreadCounters& counters )
+{
+	const uint32 sampling_rate = sites_sampling_rate.load( std::memory_order_relaxed );
+	if ( sampling_rate == 0 ) return false;
+
+	if ( counters.allocations_until_sample == 0 || counters.allocations_until_sample > sampling_rate )
+	{
+		counters.allocations_until_sample = sampling_rate;
+	}
+
+	return --counters.allocations_until_sample == 0;
+}
+
+/*
+ * Fill the callstack of the caller of the allocating function of 
+ * the profiler. Returns its depth.
+ */
+MEMORY_PROFILER_NOINLINE static uint32 capture_callstack( void** callstack )
+{
+	//	Skip this function, the sampling one and the allocating one
+	constexpr uint32 SKIPPED_FRAMES_COUNT = 3;
+
+#ifdef PLATFORM_WINDOWS
+	return RtlCaptureStackBackTrace( SKIPPED_FRAMES_COUNT, MemoryProfiler::MAX_CALLSTACK_DEPTH, callstack, nullptr );
+#elif defined( HAS_EXECINFO )
+	void* frames[MemoryProfiler::MAX_CALLSTACK_DEPTH + SKIPPED_FRAMES_COUNT];
+	const int frames_count = backtrace( frames, MemoryProfiler::MAX_CALLSTACK_DEPTH + SKIPPED_FRAMES_COUNT );
+	if ( frames_count <= static_cast<int>( SKIPPED_FRAMES_COUNT ) ) return 0;
+
+	const uint32 depth = static_cast<uint32>( frames_count ) - SKIPPED_FRAMES_COUNT;
+	std::copy( frames + SKIPPED_FRAMES_COUNT, frames + frames_count, callstack );
+	return depth;
+#else
+	return 0;
+#endif
+}
+
+MEMORY_PROFILER_NOINLINE static void sample_allocation( MemoryThreadCounters& counters, const std::size_t bytes )
+{
+	//	Ignore allocations made while sampling
+	if ( counters.is_sampling ) return;
+	counters.is_sampling = true;
+
+	void* callstack[MemoryProfiler::MAX_CALLSTACK_DEPTH];
+	const uint32 depth = capture_callstack( callstack );
+
+	//	Hash the return addresses with FNV-1a
+	uint64 hash = 14695981039346656037ull;
+	for ( uint32 i = 0; i < depth; i++ )
+	{
+		hash = ( hash ^ reinterpret_cast<uintptr_t>( callstack[i] ) ) * 1099511628211ull;
+	}
+
+	if ( depth > 0 )
+	{
+		std::lock_guard lock( sites_mutex );
+
+		//	Find the site, or add it into the first empty slot
+		MemoryAllocationSite* site = nullptr;
+		uint32 index = static_cast<uint32>( hash % MemoryProfiler::MAX_ALLOCATION_SITES_COUNT );
+		for ( uint32 i = 0; i < MemoryProfiler::MAX_ALLOCATION_SITES_COUNT; i++ )
+		{
+			MemoryAllocationSite& slot = sites[index];
+			if ( slot.depth == 0 )
+			{
+				slot.hash = hash;
+				slot.depth = depth;
+				std::copy( callstack, callstack + depth, slot.callstack );
+				slot.last_frame_index = ~0u;
+
+				site = &slot;
+				break;
+			}
+			if ( slot.hash == hash && slot.depth == depth && std::equal( callstack, callstack + depth, slot.callstack ) )
+			{
+				site = &slot;
+				break;
+			}
+
+			index = ( index + 1 ) % MemoryProfiler::MAX_ALLOCATION_SITES_COUNT;
+		}
+
+		if ( site != nullptr )
+		{
+			site->samples_count++;
+			site->sampled_bytes += bytes;
+			if ( site->last_frame_index != tracked_frames_count )
+			{
+				site->last_frame_index = tracked_frames_count;
+				site->frames_count++;
+			}
+		}
+		else
+		{
+			dropped_samples_count++;
+		}
+	}
 
-static std::unordered_map<void*, const char*> categorized_addresses {};
+	counters.is_sampling = false;
+}
 
 
 ScopedMemoryProfile::ScopedMemoryProfile( const char* name )
@@ -33,64 +398,103 @@ ScopedMemoryProfile::~ScopedMemoryProfile()
 }
 
 
-void* operator new( std::size_t bytes )
+/*
+ * Construct the allocation header right before the user memory, starting at
+ * the given offset inside the allocated memory, and count the allocation.
+ */
+static void* register_new_allocation( void* memory, const std::size_t offset, const std::size_t bytes )
 {
-	if ( bytes == 0 )
+	void* pointer = static_cast<char*>( memory ) + offset;
+	AllocationHeader* header = new ( static_cast<AllocationHeader*>( pointer ) - 1 ) AllocationHeader { bytes, current_category_index };
+
+	MemoryThreadCounters& counters = get_current_counters();
+	register_allocation_into( counters, header->category_index, bytes );
+	if ( should_sample( counters ) )
 	{
-		bytes = 1;
+		sample_allocation( counters, bytes );
 	}
 
-	//	Register into global result
-	global_result.total_instances++;
-	global_result.new_max_bytes = std::max( global_result.new_max_bytes, bytes );
-	global_result.new_min_bytes = std::min( global_result.new_min_bytes, bytes );
-	global_result.current_allocated_bytes += bytes;
-	global_result.total_allocated_bytes += bytes;
+	return pointer;
+}
 
-	//	Register into local results
-	for ( const char* name : profiled_names )
-	{
-		const MemoryProfiler::LocalResultsMap::iterator itr = local_results.find( name );
+/*
+ * Uncount the allocation of the given user memory and returns the allocated
+ * memory to free.
+ */
+static void* unregister_new_allocation( void* pointer, const std::size_t offset )
+{
+	AllocationHeader* header = static_cast<AllocationHeader*>( pointer ) - 1;
+	register_deallocation_into( get_current_counters(), header->category_index, header->bytes );
 
-		MemoryLocalProfileResult& result = itr->second;
-		result.total_instances++;
-		result.new_max_bytes = std::max( result.new_max_bytes, bytes );
-		result.new_min_bytes = std::min( result.new_min_bytes, bytes );
-		result.non_consumed_allocated_bytes += bytes;
-		result.total_allocated_bytes += bytes;
+	return static_cast<char*>( pointer ) - offset;
+}
+
+/*
+ * Returns the alignment of an over-aligned allocation, also being the offset
+ * of its user memory, so the header fits right before it.
+ */
+static std::size_t get_aligned_offset( const std::align_val_t alignment )
+{
+	return std::max( static_cast<std::size_t>( alignment ), sizeof( AllocationHeader ) );
+}
+
+static void* allocate_aligned( const std::size_t alignment, const std::size_t bytes )
+{
+#ifdef PLATFORM_WINDOWS
+	return _aligned_malloc( bytes, alignment );
+#else
+	void* memory = nullptr;
+	if ( posix_memalign( &memory, alignment, bytes ) != 0 ) return nullptr;
+
+	return memory;
+#endif
+}
+
+static void free_aligned( void* memory )
+{
+#ifdef PLATFORM_WINDOWS
+	_aligned_free( memory );
+#else
+	std::free( memory );
+#endif
+}
+
+void* operator new( std::size_t bytes )
+{
+	if ( bytes == 0 )
+	{
+		bytes = 1;
 	}
 
 	//	Basic implementation from Scott Meyers' book "Effective C++"
 	while ( true )
 	{
-		void* pointer = std::malloc( bytes );
-		if ( pointer != nullptr )
+		void* memory = std::malloc( sizeof( AllocationHeader ) + bytes );
+		if ( memory != nullptr ) return register_new_allocation( memory, sizeof( AllocationHeader ), bytes );
+
+		const std::new_handler handler = std::get_new_handler();
+		if ( handler != nullptr )
 		{
-			//	Register into current category result
-			if ( current_category == nullptr )
-			{
-				other_category_result.total_instances++;
-				other_category_result.current_instances++;
-				other_category_result.current_allocated_bytes += bytes;
-				other_category_result.total_allocated_bytes += bytes;
-			}
-			else
-			{
-				const MemoryProfiler::CategoryResultsMap::iterator itr = category_results.find( current_category );
+			( *handler )( );
+			continue;
+		}
 
-				MemoryCategoryProfileResult& result = itr->second;
-				result.total_instances++;
-				result.current_instances++;
-				result.current_allocated_bytes += bytes;
-				result.total_allocated_bytes += bytes;
+		throw std::bad_alloc();
+	}
+}
 
-				current_category = nullptr;
-				categorized_addresses.emplace( pointer, itr->first );
-				current_category = itr->first;
-			}
+void* operator new( std::size_t bytes, const std::align_val_t alignment )
+{
+	if ( bytes == 0 )
+	{
+		bytes = 1;
+	}
 
-			return pointer;
-		}
+	const std::size_t offset = get_aligned_offset( alignment );
+	while ( true )
+	{
+		void* memory = allocate_aligned( offset, offset + bytes );
+		if ( memory != nullptr ) return register_new_allocation( memory, offset, bytes );
 
 		const std::new_handler handler = std::get_new_handler();
 		if ( handler != nullptr )
@@ -103,83 +507,406 @@ void* operator new( std::size_t bytes )
 	}
 }
 
-void operator delete( void* pointer, std::size_t bytes )
+void* operator new( const std::size_t bytes, const std::nothrow_t& ) noexcept
+{
+	try
+	{
+		return ::operator new( bytes );
+	}
+	catch ( ... )
+	{
+		return nullptr;
+	}
+}
+
+void* operator new( const std::size_t bytes, const std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	try
+	{
+		return ::operator new( bytes, alignment );
+	}
+	catch ( ... )
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[]( std::size_t bytes )
+{
+	return ::operator new( bytes );
+}
+
+void* operator new[]( const std::size_t bytes, const std::align_val_t alignment )
+{
+	return ::operator new( bytes, alignment );
+}
+
+void* operator new[]( const std::size_t bytes, const std::nothrow_t& tag ) noexcept
+{
+	return ::operator new( bytes, tag );
+}
+
+void* operator new[]( const std::size_t bytes, const std::align_val_t alignment, const std::nothrow_t& tag ) noexcept
+{
+	return ::operator new( bytes, alignment, tag );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+	if ( pointer == nullptr ) return;
+
+	std::free( unregister_new_allocation( pointer, sizeof( AllocationHeader ) ) );
+}
+
+void operator delete( void* pointer, const std::align_val_t alignment ) noexcept
 {
 	if ( pointer == nullptr ) return;
 
-	//	Avoid crashing when ending the program because 'categorized_addresses' has already been released.
-	//	Not that pretty but it works.
-	bool should_profile = Engine::instance().is_running();
-	if ( should_profile )
+	free_aligned( unregister_new_allocation( pointer, get_aligned_offset( alignment ) ) );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+	::operator delete( pointer );
+}
+
+void operator delete( void* pointer, std::size_t, const std::align_val_t alignment ) noexcept
+{
+	::operator delete( pointer, alignment );
+}
+
+void operator delete( void* pointer, const std::nothrow_t& ) noexcept
+{
+	::operator delete( pointer );
+}
+
+void operator delete( void* pointer, const std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	::operator delete( pointer, alignment );
+}
+
+void operator delete[]( void* pointer ) noexcept
+{
+	::operator delete( pointer );
+}
+
+void operator delete[]( void* pointer, const std::align_val_t alignment ) noexcept
+{
+	::operator delete( pointer, alignment );
+}
+
+void operator delete[]( void* pointer, std::size_t ) noexcept
+{
+	::operator delete( pointer );
+}
+
+void operator delete[]( void* pointer, std::size_t, const std::align_val_t alignment ) noexcept
+{
+	::operator delete( pointer, alignment );
+}
+
+void operator delete[]( void* pointer, const std::nothrow_t& ) noexcept
+{
+	::operator delete( pointer );
+}
+
+void operator delete[]( void* pointer, const std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	::operator delete( pointer, alignment );
+}
+
+void* MemoryProfiler::allocate( const char* category, std::size_t bytes )
+{
+	const uint32 previous_category_index = current_category_index;
+	current_category_index = get_category_index( category );
+	void* pointer = ::operator new( bytes );
+	current_category_index = previous_category_index;
+
+	return pointer;
+}
+
+void MemoryProfiler::register_allocation( const char* category, const std::size_t bytes )
+{
+	MemoryThreadCounters& counters = get_current_counters();
+	register_allocation_into( counters, get_category_index( category ), bytes );
+	if ( should_sample( counters ) )
 	{
-		//	Register into global result
-		global_result.delete_total_calls++;
-		global_result.current_allocated_bytes -= bytes;
+		sample_allocation( counters, bytes );
+	}
+}
 
-		//	Register into local results
-		for ( const char* name : profiled_names )
-		{
-			auto itr = local_results.find( name );
+void MemoryProfiler::register_deallocation( const char* category, const std::size_t bytes )
+{
+	register_deallocation_into( get_current_counters(), get_category_index( category ), bytes );
+}
+
+void MemoryProfiler::register_arena_usage( const char* name, const std::size_t capacity, const std::size_t used_bytes, const std::size_t overflow_bytes )
+{
+	MemoryArenaProfileResult& result = arenas_results[name];
+	result.capacity = capacity;
+	result.used_bytes = used_bytes;
+	result.overflow_bytes = overflow_bytes;
+	result.high_water_mark = std::max( result.high_water_mark, used_bytes );
+}
+
+void MemoryProfiler::start_local_profiling( const char* name )
+{
+	MemoryThreadCounters& counters = get_current_counters();
+	if ( counters.active_locals_count == MAX_ACTIVE_LOCAL_SCOPES_COUNT ) return;
+
+	const uint32 index = local_scopes.find_or_add( name );
+	if ( index == MAX_LOCAL_SCOPES_COUNT ) return;
+
+	MemoryLocalCounters& local = counters.locals[index];
+	add_to_counter( local.profile_calls, 1 );
+	local.last_call_bytes.store( 0, std::memory_order_relaxed );
+	local.last_call_sequence.store( local_calls_sequence.fetch_add( 1, std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+
+	counters.active_locals[counters.active_locals_count++] = index;
+}
+
+void MemoryProfiler::stop_local_profiling( const char* name )
+{
+	MemoryThreadCounters& counters = get_current_counters();
+
+	//	Remove the most recent start of the scope
+	for ( uint32 i = counters.active_locals_count; i > 0; i-- )
+	{
+		const uint32 index = counters.active_locals[i - 1];
+		if ( std::strcmp( local_scopes.names[index], name ) != 0 ) continue;
+
+		std::copy( counters.active_locals + i, counters.active_locals + counters.active_locals_count, counters.active_locals + i - 1 );
+		counters.active_locals_count--;
+		return;
+	}
+}
+
+void MemoryProfiler::update()
+{
+	const uint32 categories_count = categories.count.load( std::memory_order_acquire );
+	const uint32 local_scopes_count = local_scopes.count.load( std::memory_order_acquire );
+
+	MemoryGlobalProfileResult new_global_result {};
+	std::size_t deallocated_bytes = 0;
+
+	MemoryCategoryProfileResult new_category_results[MAX_CATEGORIES_COUNT] {};
+	std::size_t categories_deallocated_bytes[MAX_CATEGORIES_COUNT] {};
+	std::size_t categories_deallocations_count[MAX_CATEGORIES_COUNT] {};
 
-			MemoryLocalProfileResult& result = itr->second;
-			result.delete_total_calls++;
+	MemoryLocalProfileResult new_local_results[MAX_LOCAL_SCOPES_COUNT] {};
+	std::size_t local_last_call_sequences[MAX_LOCAL_SCOPES_COUNT] {};
+
+	//	Sum the counters of all threads
+	for ( MemoryThreadCounters* counters = threads_counters.load( std::memory_order_acquire ); counters != nullptr; counters = counters->next )
+	{
+		new_global_result.total_instances += counters->global.allocations_count.load( std::memory_order_relaxed );
+		new_global_result.delete_total_calls += counters->global.deallocations_count.load( std::memory_order_relaxed );
+		new_global_result.total_allocated_bytes += counters->global.allocated_bytes.load( std::memory_order_relaxed );
+		deallocated_bytes += counters->global.deallocated_bytes.load( std::memory_order_relaxed );
+		new_global_result.new_min_bytes = std::min( new_global_result.new_min_bytes, counters->min_bytes.load( std::memory_order_relaxed ) );
+		new_global_result.new_max_bytes = std::max( new_global_result.new_max_bytes, counters->max_bytes.load( std::memory_order_relaxed ) );
+
+		for ( uint32 i = 0; i < categories_count; i++ )
+		{
+			const MemoryCategoryCounters& category = counters->categories[i];
+			new_category_results[i].total_instances += category.allocations_count.load( std::memory_order_relaxed );
+			new_category_results[i].total_allocated_bytes += category.allocated_bytes.load( std::memory_order_relaxed );
+			categories_deallocations_count[i] += category.deallocations_count.load( std::memory_order_relaxed );
+			categories_deallocated_bytes[i] += category.deallocated_bytes.load( std::memory_order_relaxed );
 		}
 
-		//	Register into category result
-		const auto itr = categorized_addresses.find( pointer );
-		if ( itr != categorized_addresses.end() )
+		for ( uint32 i = 0; i < local_scopes_count; i++ )
 		{
-			const char* category = itr->second;
+			const MemoryLocalCounters& local = counters->locals[i];
+			MemoryLocalProfileResult& result = new_local_results[i];
+			result.total_instances += local.allocations_count.load( std::memory_order_relaxed );
+			result.delete_total_calls += local.deallocations_count.load( std::memory_order_relaxed );
+			result.total_allocated_bytes += local.allocated_bytes.load( std::memory_order_relaxed );
+			result.total_profile_calls += local.profile_calls.load( std::memory_order_relaxed );
+			result.new_min_bytes = std::min( result.new_min_bytes, local.min_bytes.load( std::memory_order_relaxed ) );
+			result.new_max_bytes = std::max( result.new_max_bytes, local.max_bytes.load( std::memory_order_relaxed ) );
+
+			//	Keep the last call among all threads
+			const std::size_t sequence = local.last_call_sequence.load( std::memory_order_relaxed );
+			if ( sequence > local_last_call_sequences[i] )
+			{
+				local_last_call_sequences[i] = sequence;
+				result.non_consumed_allocated_bytes = local.last_call_bytes.load( std::memory_order_relaxed );
+			}
+		}
+	}
 
-			const MemoryProfiler::CategoryResultsMap::iterator category_result_itr = category_results.find( category );
-			//	TODO: Check whether it's a good idea to put an assert in a critical operator.
-			ASSERT( category_result_itr != category_results.end() );
+	//	Counters of other threads may be slightly out of sync, avoid underflows
+	new_global_result.current_allocated_bytes = new_global_result.total_allocated_bytes - std::min( deallocated_bytes, new_global_result.total_allocated_bytes );
 
-			MemoryCategoryProfileResult& result = category_result_itr->second;
-			result.current_instances--;
-			result.current_allocated_bytes -= bytes;
+	//	Compute the allocations since the previous update
+	frame_result.allocations_count = new_global_result.total_instances - global_result.total_instances;
+	frame_result.deallocations_count = new_global_result.delete_total_calls - global_result.delete_total_calls;
+	frame_result.allocated_bytes = new_global_result.total_allocated_bytes - global_result.total_allocated_bytes;
+	global_result = new_global_result;
 
-			categorized_addresses.erase( itr );
-		}
-		else
+	if ( is_tracking_sites() )
+	{
+		std::lock_guard lock( sites_mutex );
+		tracked_frames_count++;
+	}
+
+	for ( uint32 i = 0; i < categories_count; i++ )
+	{
+		MemoryCategoryProfileResult& result = new_category_results[i];
+		result.current_instances = result.total_instances - std::min( categories_deallocations_count[i], result.total_instances );
+		result.current_allocated_bytes = result.total_allocated_bytes - std::min( categories_deallocated_bytes[i], result.total_allocated_bytes );
+
+		if ( i == 0 )
 		{
-			other_category_result.current_instances--;
-			other_category_result.current_allocated_bytes -= bytes;
+			other_category_result = result;
+			continue;
 		}
+
+		category_results[categories.names[i]] = result;
 	}
 
-	std::free( pointer );
+	for ( uint32 i = 0; i < local_scopes_count; i++ )
+	{
+		local_results[local_scopes.names[i]] = new_local_results[i];
+	}
 }
 
-void* MemoryProfiler::allocate( const char* category, std::size_t bytes )
+void MemoryProfiler::start_sites_tracking( const uint32 sampling_rate )
 {
-	_set_current_category( category );
-	void* pointer = ::operator new( bytes );
-	_unset_current_category();
+	{
+		std::lock_guard lock( sites_mutex );
+		std::fill( std::begin( sites ), std::end( sites ), MemoryAllocationSite {} );
+		tracked_frames_count = 0;
+		dropped_samples_count = 0;
+	}
 
-	return pointer;
+	sites_sampling_rate.store( std::max( sampling_rate, 1u ), std::memory_order_relaxed );
+	Logger::info( "MemoryProfiler: Tracking allocation sites, sampling 1 allocation every %d", sampling_rate );
 }
 
-void MemoryProfiler::start_local_profiling( const char* name )
+void MemoryProfiler::stop_sites_tracking()
+{
+	sites_sampling_rate.store( 0, std::memory_order_relaxed );
+}
+
+bool MemoryProfiler::is_tracking_sites()
 {
-	LocalResultsMap::iterator itr = local_results.find( name );
-	if ( itr == local_results.end() )
+	return sites_sampling_rate.load( std::memory_order_relaxed ) != 0;
+}
+
+std::vector<MemoryAllocationSiteResult> MemoryProfiler::get_top_allocation_sites( const int count )
+{
+	std::vector<MemoryAllocationSiteResult> results {};
+
+	//	Ignore the allocations of the results, as sampling them would lock again
+	MemoryThreadCounters& counters = get_current_counters();
+	const bool was_sampling = counters.is_sampling;
+	counters.is_sampling = true;
 	{
-		itr = local_results.emplace( name, MemoryLocalProfileResult {} ).first;
+		std::lock_guard lock( sites_mutex );
+
+		//	Estimate the allocations from the samples
+		const float sampling_rate = static_cast<float>( std::max( sites_sampling_rate.load( std::memory_order_relaxed ), 1u ) );
+		const float frames_count = static_cast<float>( std::max( tracked_frames_count, 1u ) );
+		for ( const MemoryAllocationSite& site : sites )
+		{
+			if ( site.depth == 0 ) continue;
+
+			MemoryAllocationSiteResult& result = results.emplace_back();
+			result.callstack.assign( site.callstack, site.callstack + site.depth );
+			result.allocations_per_frame = site.samples_count * sampling_rate / frames_count;
+			result.bytes_per_frame = site.sampled_bytes * sampling_rate / frames_count;
+			result.frames_ratio = std::min( site.frames_count / frames_count, 1.0f );
+		}
 	}
+	counters.is_sampling = was_sampling;
 
-	itr->second.total_profile_calls++;
-	itr->second.non_consumed_allocated_bytes = 0;
+	std::sort( results.begin(), results.end(),
+		[]( const MemoryAllocationSiteResult& a, const MemoryAllocationSiteResult& b )
+		{
+			return a.allocations_per_frame > b.allocations_per_frame;
+		}
+	);
+	if ( static_cast<int>( results.size() ) > count )
+	{
+		results.resize( count );
+	}
+	return results;
+}
 
-	profiled_names.push_back( name );
+void MemoryProfiler::dump_top_allocation_sites( const int count )
+{
+	const std::vector<MemoryAllocationSiteResult> results = get_top_allocation_sites( count );
+	Logger::info( "MemoryProfiler: Top %d allocation sites over %d frames", static_cast<int>( results.size() ), tracked_frames_count );
+
+	for ( std::size_t i = 0; i < results.size(); i++ )
+	{
+		const MemoryAllocationSiteResult& result = results[i];
+		Logger::info(
+			"#%d: %.1f allocations (%.0f bytes) per frame, in %.0f%% of frames",
+			static_cast<int>( i + 1 ),
+			result.allocations_per_frame, result.bytes_per_frame,
+			result.frames_ratio * 100.0f
+		);
+
+		for ( void* address : result.callstack )
+		{
+			Logger::info( "    %s", *get_symbol_name( address ) );
+		}
+	}
 }
 
-void MemoryProfiler::stop_local_profiling( const char* name )
+std::string MemoryProfiler::get_symbol_name( void* address )
 {
-	auto itr = std::find( profiled_names.begin(), profiled_names.end(), name );
-	if ( itr == profiled_names.end() ) return;
+#ifdef PLATFORM_WINDOWS
+	//	DbgHelp isn't thread-safe
+	static std::mutex symbols_mutex {};
+	std::lock_guard lock( symbols_mutex );
+
+	const HANDLE process = GetCurrentProcess();
+	static bool is_initialized = false;
+	if ( !is_initialized )
+	{
+		SymSetOptions( SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES );
+		SymInitialize( process, nullptr, TRUE );
+		is_initialized = true;
+	}
+
+	alignas( SYMBOL_INFO ) char buffer[sizeof( SYMBOL_INFO ) + MAX_SYM_NAME] {};
+	SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>( buffer );
+	symbol->SizeOfStruct = sizeof( SYMBOL_INFO );
+	symbol->MaxNameLen = MAX_SYM_NAME;
 
-	profiled_names.erase( itr );
+	const DWORD64 symbol_address = reinterpret_cast<DWORD64>( address );
+	DWORD64 displacement = 0;
+	if ( SymFromAddr( process, symbol_address, &displacement, symbol ) )
+	{
+		std::string name = symbol->Name;
+
+		IMAGEHLP_LINE64 line {};
+		line.SizeOfStruct = sizeof( IMAGEHLP_LINE64 );
+		DWORD line_displacement = 0;
+		if ( SymGetLineFromAddr64( process, symbol_address, &line_displacement, &line ) )
+		{
+			name += " (" + std::string( line.FileName ) + ":" + std::to_string( line.LineNumber ) + ")";
+		}
+
+		return name;
+	}
+#elif defined( HAS_EXECINFO )
+	char** symbols = backtrace_symbols( &address, 1 );
+	if ( symbols != nullptr )
+	{
+		std::string name = symbols[0];
+		std::free( symbols );
+		return name;
+	}
+#endif
+
+	char buffer[32];
+	std::snprintf( buffer, sizeof( buffer ), "%p", address );
+	return buffer;
 }
 
 const MemoryGlobalProfileResult& MemoryProfiler::get_global_result()
@@ -187,6 +914,11 @@ const MemoryGlobalProfileResult& MemoryProfiler::get_global_result()
 	return global_result;
 }
 
+const MemoryFrameProfileResult& MemoryProfiler::get_frame_result()
+{
+	return frame_result;
+}
+
 const MemoryProfiler::LocalResultsMap& MemoryProfiler::get_local_results()
 {
 	return local_results;
@@ -202,21 +934,8 @@ const MemoryCategoryProfileResult& MemoryProfiler::get_other_category_result()
 	return other_category_result;
 }
 
-
-void MemoryProfiler::_set_current_category( const char* category )
-{
-	//	Create category if it doesn't exist yet
-	const CategoryResultsMap::const_iterator itr = category_results.find( category );
-	if ( itr == category_results.end() )
-	{
-		category_results.emplace( category, MemoryCategoryProfileResult {} ).first;
-	}
-
-	current_category = category;
-}
-
-void MemoryProfiler::_unset_current_category()
+const MemoryProfiler::ArenaResultsMap& MemoryProfiler::get_arenas_results()
 {
-	current_category = nullptr;
+	return arenas_results;
 }
-#endif
\ No newline at end of file
+#endif
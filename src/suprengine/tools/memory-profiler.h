@@ -1,15 +1,19 @@
 #pragma once
 
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/usings.h>
+
 #ifdef ENABLE_MEMORY_PROFILER
-#define MEMORY_SCOPE( name ) ScopedMemoryProfile _scoped_memory_profile##__LINE__( name )
+#define MEMORY_SCOPE( name ) ScopedMemoryProfile SUPRENGINE_CONCAT( _scoped_memory_profile, __LINE__ )( name )
 #else
 #define MEMORY_SCOPE( name )
 #endif
 
 #ifdef ENABLE_MEMORY_PROFILER
-#include <suprengine/utils/usings.h>
-
-#include <map>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
 
 namespace suprengine
 {
@@ -48,6 +52,49 @@ namespace suprengine
 		std::size_t current_allocated_bytes = 0;
 	};
 
+	/*
+	 * Allocations between the last two updates, so usually over a frame.
+	 */
+	struct MemoryFrameProfileResult
+	{
+		std::size_t allocations_count = 0;
+		std::size_t deallocations_count = 0;
+		std::size_t allocated_bytes = 0;
+	};
+
+	/*
+	 * Allocations of a call site, estimated from sampled callstacks.
+	 */
+	struct MemoryAllocationSiteResult
+	{
+		/*
+		 * Return addresses, starting from the allocating function.
+		 */
+		std::vector<void*> callstack {};
+
+		float allocations_per_frame = 0.0f;
+		float bytes_per_frame = 0.0f;
+		/*
+		 * Ratio of the tracked frames in which the site has been sampled.
+		 */
+		float frames_ratio = 0.0f;
+	};
+
+	/*
+	 * Usage of a linear allocator, such as the frame arena.
+	 */
+	struct MemoryArenaProfileResult
+	{
+		std::size_t capacity = 0;
+		/*
+		 * Bytes used before the last reset, including the overflowing
+		 * ones allocated on the heap.
+		 */
+		std::size_t used_bytes = 0;
+		std::size_t overflow_bytes = 0;
+		std::size_t high_water_mark = 0;
+	};
+
 	class ScopedMemoryProfile
 	{
 	public:
@@ -58,37 +105,104 @@ namespace suprengine
 		const char* name = nullptr;
 	};
 
+	/*
+	 * Memory profiler replacing the global 'new' and 'delete' operators, thread-safe.
+	 *
+	 * Each allocation is prefixed by a header storing its size and category,
+	 * so deallocations don't need any lookup. Each thread counts into its own
+	 * block of counters, without locking, and blocks are merged into the
+	 * results at each update. Results are thus only refreshed once per frame.
+	 *
+	 * Categories and local scopes are identified by their name, and limited
+	 * to MAX_CATEGORIES_COUNT and MAX_LOCAL_SCOPES_COUNT; the exceeding ones
+	 * are counted as "Other" or not counted. Local scopes only count the
+	 * allocations of the thread they are started on. Over-aligned
+	 * allocations aren't profiled.
+	 *
+	 * Call sites allocating every frame can be found by tracking sites,
+	 * which samples the callstacks of allocations.
+	 */
 	class MemoryProfiler
 	{
 	public:
-		using LocalResultsMap = std::map<const char*, MemoryLocalProfileResult>;
-		using CategoryResultsMap = std::map<const char*, MemoryCategoryProfileResult>;
+		using LocalResultsMap = FlatHashMap<const char*, MemoryLocalProfileResult>;
+		using CategoryResultsMap = FlatHashMap<const char*, MemoryCategoryProfileResult>;
+		using ArenaResultsMap = FlatHashMap<const char*, MemoryArenaProfileResult>;
+
+		static constexpr uint32 MAX_CATEGORIES_COUNT = 64;
+		static constexpr uint32 MAX_LOCAL_SCOPES_COUNT = 64;
+		/*
+		 * Maximum amount of nested local scopes on a thread.
+		 */
+		static constexpr uint32 MAX_ACTIVE_LOCAL_SCOPES_COUNT = 16;
+
+		static constexpr uint32 MAX_CALLSTACK_DEPTH = 16;
+		static constexpr uint32 MAX_ALLOCATION_SITES_COUNT = 1024;
 
 	public:
 		template <typename T, typename ...Args>
 		static T* allocate( const char* category, Args ...args )
 		{
-			_set_current_category( category );
-			T* pointer = new T( args... );
-			_unset_current_category();
-
-			return pointer;
+			T* pointer = static_cast<T*>( allocate( category, sizeof( T ) ) );
+			return new ( pointer ) T( args... );
 		}
 
 		static void* allocate( const char* category, std::size_t bytes );
 
+		/*
+		 * Register an allocation served by a custom allocator into the
+		 * given category, without going through the global 'new' operator.
+		 */
+		static void register_allocation( const char* category, std::size_t bytes );
+		static void register_deallocation( const char* category, std::size_t bytes );
+		/*
+		 * Register the usage of a linear allocator before its reset.
+		 * Must be called from the main thread.
+		 */
+		static void register_arena_usage( const char* name, std::size_t capacity, std::size_t used_bytes, std::size_t overflow_bytes );
+
 		static void start_local_profiling( const char* name );
 		static void stop_local_profiling( const char* name );
 
+		/*
+		 * Merge the counters of all threads into the results.
+		 * Called by the engine at the end of each frame, from the main thread.
+		 */
+		static void update();
+
+		/*
+		 * Start recording the callstack of one allocation every 'sampling_rate'
+		 * allocations of each thread, grouping them by call site.
+		 * Previously tracked sites are cleared.
+		 */
+		static void start_sites_tracking( uint32 sampling_rate );
+		static void stop_sites_tracking();
+		static bool is_tracking_sites();
+
+		/*
+		 * Returns the call sites allocating the most per tracked frame,
+		 * up to the given count.
+		 */
+		static std::vector<MemoryAllocationSiteResult> get_top_allocation_sites( int count );
+		/*
+		 * Log the call sites allocating the most per tracked frame, along
+		 * with their callstacks.
+		 */
+		static void dump_top_allocation_sites( int count );
+		/*
+		 * Returns the function name and, when available, the source
+		 * location of the code address.
+		 */
+		static std::string get_symbol_name( void* address );
+
 		static const MemoryGlobalProfileResult& get_global_result();
+		static const MemoryFrameProfileResult& get_frame_result();
 		static const LocalResultsMap& get_local_results();
 
 		static const CategoryResultsMap& get_custom_categories_results();
 		static const MemoryCategoryProfileResult& get_other_category_result();
 
-	private:
-		static void _set_current_category( const char* category );
-		static void _unset_current_category();
+		static const ArenaResultsMap& get_arenas_results();
 	};
 }
 #endif
\ No newline at end of file
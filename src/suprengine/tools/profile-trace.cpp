@@ -0,0 +1,194 @@
+#include "profile-trace.h"
+
+#include <suprengine/tools/memory-profiler.h>
+#include <suprengine/tools/profiler.h>
+
+#include <suprengine/utils/json.h>
+#include <suprengine/utils/logger.h>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace suprengine;
+
+//	Traces are large, don't waste space on indentation
+using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+//	Identifier of the process in the trace, as all threads belong to the same one
+constexpr int TRACE_PROCESS_ID = 1;
+
+ProfileTrace::ProfileTrace( const int frames_count, const int64 start_time )
+	: _frames_count( frames_count ), _start_time( start_time )
+{
+	_frames.reserve( frames_count );
+
+#ifdef ENABLE_MEMORY_PROFILER
+	_last_allocations_count = MemoryProfiler::get_global_result().total_instances;
+#endif
+}
+
+void ProfileTrace::add_scope( const uint32 thread_index, const uint32 scope_id, const int64 begin_time, const int64 end_time )
+{
+	if ( is_finished() ) return;
+
+	//	Cut scopes begun before the capture
+	_scopes.push_back( ScopeEvent { thread_index, scope_id, std::max( begin_time, _start_time ), end_time } );
+}
+
+void ProfileTrace::add_frame( const int64 time )
+{
+	if ( is_finished() ) return;
+
+	FrameEvent& frame = _frames.emplace_back();
+	frame.time = time;
+
+#ifdef ENABLE_MEMORY_PROFILER
+	const MemoryGlobalProfileResult& memory_result = MemoryProfiler::get_global_result();
+	frame.current_allocated_bytes = memory_result.current_allocated_bytes;
+	frame.allocations_count = memory_result.total_instances - _last_allocations_count;
+	_last_allocations_count = memory_result.total_instances;
+#endif
+}
+
+bool ProfileTrace::is_finished() const
+{
+	return get_captured_frames_count() >= _frames_count;
+}
+
+int ProfileTrace::get_captured_frames_count() const
+{
+	return static_cast<int>( _frames.size() );
+}
+
+int ProfileTrace::get_frames_count() const
+{
+	return _frames_count;
+}
+
+bool ProfileTrace::write( rconst_str path, const std::vector<std::string>& thread_names ) const
+{
+	//	Convert nanoseconds to the microseconds of the format
+	const auto to_trace_time = [this]( const int64 time )
+	{
+		return ( time - _start_time ) * 0.001;
+	};
+
+	rapidjson::StringBuffer buffer {};
+	JsonWriter writer( buffer );
+
+	writer.StartObject();
+	writer.Key( "displayTimeUnit" );
+	writer.String( "ms" );
+
+	writer.Key( "traceEvents" );
+	writer.StartArray();
+
+	//	Name threads
+	for ( std::size_t i = 0; i < thread_names.size(); i++ )
+	{
+		writer.StartObject();
+		writer.Key( "name" );
+		writer.String( "thread_name" );
+		writer.Key( "ph" );
+		writer.String( "M" );
+		writer.Key( "pid" );
+		writer.Int( TRACE_PROCESS_ID );
+		writer.Key( "tid" );
+		writer.Uint( static_cast<uint32>( i ) );
+		writer.Key( "args" );
+		writer.StartObject();
+		writer.Key( "name" );
+		writer.String( thread_names[i].c_str() );
+		writer.EndObject();
+		writer.EndObject();
+	}
+
+	//	Scopes as complete events, nesting being deduced from their times
+	for ( const ScopeEvent& scope : _scopes )
+	{
+		writer.StartObject();
+		writer.Key( "name" );
+		writer.String( Profiler::get_scope_name( scope.scope_id ) );
+		writer.Key( "cat" );
+		writer.String( "scope" );
+		writer.Key( "ph" );
+		writer.String( "X" );
+		writer.Key( "ts" );
+		writer.Double( to_trace_time( scope.begin_time ) );
+		writer.Key( "dur" );
+		writer.Double( ( scope.end_time - scope.begin_time ) * 0.001 );
+		writer.Key( "pid" );
+		writer.Int( TRACE_PROCESS_ID );
+		writer.Key( "tid" );
+		writer.Uint( scope.thread_index );
+		writer.EndObject();
+	}
+
+	//	Frames as global instant events and memory counters
+	for ( std::size_t i = 0; i < _frames.size(); i++ )
+	{
+		const FrameEvent& frame = _frames[i];
+		const double time = to_trace_time( frame.time );
+
+		writer.StartObject();
+		writer.Key( "name" );
+		writer.String( ( "Frame " + std::to_string( i ) ).c_str() );
+		writer.Key( "ph" );
+		writer.String( "i" );
+		writer.Key( "s" );
+		writer.String( "g" );
+		writer.Key( "ts" );
+		writer.Double( time );
+		writer.Key( "pid" );
+		writer.Int( TRACE_PROCESS_ID );
+		writer.Key( "tid" );
+		writer.Int( 0 );
+		writer.EndObject();
+
+	#ifdef ENABLE_MEMORY_PROFILER
+		const std::pair<const char*, std::size_t> counters[] {
+			{ "Allocated Bytes", frame.current_allocated_bytes },
+			{ "Allocations", frame.allocations_count },
+		};
+		for ( const auto& [name, value] : counters )
+		{
+			writer.StartObject();
+			writer.Key( "name" );
+			writer.String( name );
+			writer.Key( "ph" );
+			writer.String( "C" );
+			writer.Key( "ts" );
+			writer.Double( time );
+			writer.Key( "pid" );
+			writer.Int( TRACE_PROCESS_ID );
+			writer.Key( "args" );
+			writer.StartObject();
+			writer.Key( "value" );
+			writer.Uint64( value );
+			writer.EndObject();
+			writer.EndObject();
+		}
+	#endif
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+
+	//  Write to file
+	std::ofstream file( path );
+	if ( !file.is_open() )
+	{
+		Logger::error( "Failed to write profile trace at path '%s'!", *path );
+		return false;
+	}
+	file << buffer.GetString();
+
+	Logger::info(
+		"Wrote profile trace of %d frames and %d scopes at path '%s'",
+		get_captured_frames_count(), static_cast<int>( _scopes.size() ), *path
+	);
+	return true;
+}
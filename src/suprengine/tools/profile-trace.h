@@ -0,0 +1,66 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <string>
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Captures the profiled scopes of all threads over a given amount of
+	 * frames and writes them as a Chrome Trace Event JSON file, which opens
+	 * in chrome://tracing and ui.perfetto.dev.
+	 *
+	 * Each frame is marked by an instant event and, when compiled with
+	 * ENABLE_MEMORY_PROFILER, by counters of the allocated memory.
+	 * Times are given in nanoseconds of the steady clock.
+	 */
+	class ProfileTrace
+	{
+	public:
+		ProfileTrace( int frames_count, int64 start_time );
+
+		void add_scope( uint32 thread_index, uint32 scope_id, int64 begin_time, int64 end_time );
+		/*
+		 * Mark the end of a frame, sampling memory counters.
+		 */
+		void add_frame( int64 time );
+
+		bool is_finished() const;
+		int get_captured_frames_count() const;
+		int get_frames_count() const;
+
+		/*
+		 * Write the trace at the given path, naming threads by their index.
+		 * Returns whenever the file could be written.
+		 */
+		bool write( rconst_str path, const std::vector<std::string>& thread_names ) const;
+
+	private:
+		struct ScopeEvent
+		{
+			uint32 thread_index = 0;
+			uint32 scope_id = 0;
+			int64 begin_time = 0;
+			int64 end_time = 0;
+		};
+
+		struct FrameEvent
+		{
+			int64 time = 0;
+
+			std::size_t current_allocated_bytes = 0;
+			std::size_t allocations_count = 0;
+		};
+
+	private:
+		int _frames_count = 0;
+		int64 _start_time = 0;
+
+		std::vector<ScopeEvent> _scopes {};
+		std::vector<FrameEvent> _frames {};
+
+		std::size_t _last_allocations_count = 0;
+	};
+}
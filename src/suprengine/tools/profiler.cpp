@@ -2,6 +2,8 @@
 
 #include <suprengine/core/engine.h>
 
+#include <suprengine/utils/logger.h>
+#include <suprengine/utils/string-id.h>
 #include <suprengine/utils/string-library.h>
 
 #include <suprengine/tools/vis-debug.h>
@@ -10,6 +12,17 @@
 #include <implot.h>
 #include <implot_internal.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#include <intrin.h>
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
 using namespace suprengine;
 
 //	Frame-per-second target to profile data on the timeline
@@ -20,8 +33,131 @@ constexpr float TIMELINE_MAX_TIME = 60.0f;
 constexpr int TIMELINE_DATA_SIZE = static_cast<int>( TIMELINE_MAX_TIME * TIMELINE_FPS_TARGET );
 constexpr double TIMELINE_BAR_SIZE = 1.0 / TIMELINE_MAX_TIME;
 
-ProfileTimer::ProfileTimer( const char* name, bool is_running, bool should_log )
-	: name( name ), _should_log( should_log )
+namespace suprengine
+{
+	struct ProfileEvent
+	{
+		/*
+		 * Raw ticks, converted to time on collection.
+		 */
+		uint64 ticks = 0;
+		uint32 scope_id = 0;
+		bool is_begin = false;
+	};
+
+	/*
+	 * Single-producer single-consumer ring buffer of the events of a thread.
+	 * Only the owning thread writes events, only the profiler reads them.
+	 */
+	struct ProfileThreadBuffer
+	{
+		static constexpr uint32 CAPACITY = 1 << 15;
+		static constexpr uint32 MASK = CAPACITY - 1;
+
+		ProfileEvent events[CAPACITY] {};
+
+		alignas( 64 ) std::atomic<uint32> write_index { 0 };
+		alignas( 64 ) std::atomic<uint32> read_index { 0 };
+
+		/*
+		 * Owner thread only: amount of recorded scopes not yet ended,
+		 * and of dropped scopes not yet ended.
+		 */
+		uint32 open_depth = 0;
+		uint32 dropped_depth = 0;
+		/*
+		 * Owner thread only: last known read index, only refreshed
+		 * when the buffer seems full to avoid sharing its cache line.
+		 */
+		uint32 cached_read_index = 0;
+
+		std::atomic<uint32> dropped_events_count { 0 };
+
+		/*
+		 * Protected by the buffers mutex.
+		 */
+		std::string name {};
+	};
+}
+
+static std::mutex buffers_mutex {};
+static std::vector<std::unique_ptr<ProfileThreadBuffer>> buffers {};
+static thread_local ProfileThreadBuffer* current_buffer = nullptr;
+
+static std::mutex scopes_mutex {};
+static FlatHashMap<StringId, uint32> scope_ids {};
+static std::vector<const char*> scope_names {};
+
+static std::atomic<bool> is_recording { false };
+
+static int64 get_time_ns()
+{
+	return chrono::duration_cast<chrono::nanoseconds>( chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/*
+ * Returns a cheap monotonic tick count, of unknown frequency.
+ */
+static uint64 read_ticks()
+{
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+	return __rdtsc();
+#else
+	return static_cast<uint64>( chrono::steady_clock::now().time_since_epoch().count() );
+#endif
+}
+
+static ProfileThreadBuffer& get_current_buffer()
+{
+	if ( current_buffer != nullptr ) return *current_buffer;
+
+	std::lock_guard lock( buffers_mutex );
+	std::unique_ptr<ProfileThreadBuffer>& buffer = buffers.emplace_back( std::make_unique<ProfileThreadBuffer>() );
+	buffer->name = "Thread " + std::to_string( buffers.size() - 1 );
+
+	current_buffer = buffer.get();
+	return *current_buffer;
+}
+
+static void push_event( ProfileThreadBuffer& buffer, const uint32 scope_id, const bool is_begin )
+{
+	const uint32 write_index = buffer.write_index.load( std::memory_order_relaxed );
+	buffer.events[write_index & ProfileThreadBuffer::MASK] = ProfileEvent { read_ticks(), scope_id, is_begin };
+	buffer.write_index.store( write_index + 1, std::memory_order_release );
+}
+
+/*
+ * Returns the index of the child node of given scope, adding it if needed.
+ */
+static int find_or_add_child( ProfileThreadTree& tree, const int parent_index, const uint32 scope_id )
+{
+	int last_child_index = INDEX_NONE;
+	for ( int index = tree.nodes[parent_index].first_child; index != INDEX_NONE; index = tree.nodes[index].next_sibling )
+	{
+		if ( tree.nodes[index].scope_id == scope_id ) return index;
+		last_child_index = index;
+	}
+
+	const int index = static_cast<int>( tree.nodes.size() );
+	ProfileNode& node = tree.nodes.emplace_back();
+	node.scope_id = scope_id;
+	node.parent = parent_index;
+
+	//	Append to keep siblings in calling order
+	if ( last_child_index == INDEX_NONE )
+	{
+		tree.nodes[parent_index].first_child = index;
+	}
+	else
+	{
+		tree.nodes[last_child_index].next_sibling = index;
+	}
+
+	return index;
+}
+
+ProfileTimer::ProfileTimer( const char* name, bool is_running )
+	: name( name )
 {
 	if ( is_running )
 	{
@@ -37,7 +173,7 @@ ProfileTimer::~ProfileTimer()
 void ProfileTimer::start()
 {
 	_is_running = true;
-	_start_timepoint = chrono::high_resolution_clock::now();
+	_start_timepoint = chrono::steady_clock::now();
 }
 
 void ProfileTimer::stop()
@@ -45,14 +181,6 @@ void ProfileTimer::stop()
 	if ( !is_running() ) return;
 
 	_total_time = get_time();
-
-	if ( _should_log )
-	{
-		//	Add result to profiler
-		Profiler* profiler = Engine::instance().get_profiler();
-		profiler->add_result( name, _total_time );
-	}
-
 	_is_running = false;
 }
 
@@ -75,47 +203,100 @@ float ProfileTimer::get_time() const
 {
 	if ( !is_running() ) return _total_time;
 
-	//	Compute start and end times
-	TimePoint end_timepoint = chrono::high_resolution_clock::now();
-	long long start_ms = chrono::time_point_cast<chrono::microseconds>( _start_timepoint ).time_since_epoch().count();
-	long long end_ms = chrono::time_point_cast<chrono::microseconds>( end_timepoint ).time_since_epoch().count();
-
 	//	Compute time difference of timepoints in milliseconds
-	float time = ( end_ms - start_ms ) * 0.001f;
+	const TimePoint end_timepoint = chrono::steady_clock::now();
+	const float time = chrono::duration<float, std::milli>( end_timepoint - _start_timepoint ).count();
 	return _total_time + time;
 }
 
 
 Profiler::Profiler( bool is_running )
-	: _timer( "Profiler", is_running, /* should_log */ false )
-{}
+	: _timer( "Profiler", is_running )
+{
+	is_recording.store( is_running, std::memory_order_relaxed );
+	_last_update_time = get_time_ns();
+
+	_base_ticks = read_ticks();
+	_base_time = _last_update_time;
+	_nanoseconds_per_tick = static_cast<double>( chrono::steady_clock::period::num ) * 1.0e9 / chrono::steady_clock::period::den;
+}
 
-void Profiler::add_result( const char* name, float time )
+uint32 Profiler::register_scope( const char* name )
 {
-	if ( !is_profiling() ) return;
+	std::lock_guard lock( scopes_mutex );
+
+	//	Match by content, as the same literal may have different addresses
+	const StringId id = StringId::intern( name );
+	const auto itr = scope_ids.find( id );
+	if ( itr != scope_ids.end() ) return itr->second;
+
+	const uint32 scope_id = static_cast<uint32>( scope_names.size() );
+	scope_ids.emplace( id, scope_id );
+	scope_names.push_back( name );
+	return scope_id;
+}
+
+const char* Profiler::get_scope_name( const uint32 scope_id )
+{
+	std::lock_guard lock( scopes_mutex );
+	if ( scope_id >= scope_names.size() ) return "Unknown";
 
-	auto itr = _results.find( name );
-	if ( itr == _results.end() )
+	return scope_names[scope_id];
+}
+
+bool Profiler::begin_scope( const uint32 scope_id )
+{
+	if ( !is_recording.load( std::memory_order_relaxed ) ) return false;
+
+	ProfileThreadBuffer& buffer = get_current_buffer();
+
+	//	Keep room for the ends of all open scopes, dropping child scopes of 
+	//	dropped ones so the nesting stays consistent
+	const uint32 write_index = buffer.write_index.load( std::memory_order_relaxed );
+	const uint32 required_count = buffer.open_depth + 2;
+	if ( write_index - buffer.cached_read_index + required_count > ProfileThreadBuffer::CAPACITY )
+	{
+		buffer.cached_read_index = buffer.read_index.load( std::memory_order_acquire );
+	}
+	if ( buffer.dropped_depth > 0 || write_index - buffer.cached_read_index + required_count > ProfileThreadBuffer::CAPACITY )
+	{
+		buffer.dropped_depth++;
+		buffer.dropped_events_count.fetch_add( 1, std::memory_order_relaxed );
+		return true;
+	}
+
+	push_event( buffer, scope_id, /* is_begin */ true );
+	buffer.open_depth++;
+	return true;
+}
+
+void Profiler::end_scope( const uint32 scope_id )
+{
+	ProfileThreadBuffer& buffer = get_current_buffer();
+	if ( buffer.dropped_depth > 0 )
 	{
-		itr = _results.emplace( name, ProfileResult {} ).first;
+		buffer.dropped_depth--;
+		return;
 	}
 
-	ProfileResult& result = itr->second;
-	result.time = time;
-	result.max_time = std::max( result.max_time, time );
-	result.min_time = std::min( result.min_time, time );
-	result.total_time += time;
-	result.non_consumed_time += time;
-	result.total_calls++;
-	result.non_consumed_calls++;
+	push_event( buffer, scope_id, /* is_begin */ false );
+	buffer.open_depth--;
+}
+
+void Profiler::set_thread_name( rconst_str name )
+{
+	ProfileThreadBuffer& buffer = get_current_buffer();
+
+	std::lock_guard lock( buffers_mutex );
+	buffer.name = name;
 }
 
 void Profiler::consume_results()
 {
-	for ( auto& pair : _results )
+	for ( ProfileResult& result : _results )
 	{
-		ProfileResult& result = pair.second;
 		result.non_consumed_time = 0.0f;
+		result.non_consumed_self_time = 0.0f;
 		result.non_consumed_calls = 0;
 	}
 }
@@ -123,6 +304,7 @@ void Profiler::consume_results()
 void Profiler::clear()
 {
 	_results.clear();
+	_frame_histogram.clear();
 	_timer.clear();
 	_timelines.clear();
 }
@@ -130,34 +312,83 @@ void Profiler::clear()
 void Profiler::start()
 {
 	_timer.start();
+	is_recording.store( true, std::memory_order_relaxed );
 }
 
 void Profiler::stop()
 {
 	_timer.stop();
+	is_recording.store( false, std::memory_order_relaxed );
 }
 
 void Profiler::update()
 {
+	_calibrate_clock();
+
+	const int64 time = get_time_ns();
+	_last_frame.duration = ( time - _last_update_time ) * 1.0e-6f;
+	_last_update_time = time;
+
+	//	Make room for the results of newly registered scopes
+	{
+		std::lock_guard lock( scopes_mutex );
+		while ( _results.size() < scope_names.size() )
+		{
+			ProfileResult& result = _results.emplace_back();
+			result.name = scope_names[_results.size() - 1];
+		}
+	}
+
+	//	Collect events of each thread, the lock only preventing
+	//	registrations of new threads
+	{
+		std::lock_guard lock( buffers_mutex );
+		_last_frame.threads.resize( buffers.size() );
+		_threads_states.resize( buffers.size() );
+		for ( std::size_t i = 0; i < buffers.size(); i++ )
+		{
+			ProfileThreadTree& tree = _last_frame.threads[i];
+			tree.thread_name = buffers[i]->name;
+			_collect_thread( static_cast<uint32>( i ), *buffers[i], _threads_states[i], tree );
+		}
+	}
+
+	if ( _trace != nullptr )
+	{
+		_trace->add_frame( time );
+		if ( _trace->is_finished() )
+		{
+			stop_trace();
+		}
+	}
+
 	if ( !is_profiling() ) return;
 
-	auto& engine = Engine::instance();
-	auto updater = engine.get_updater();
+	//	Slide the percentiles windows
+	_frame_histogram.record( static_cast<uint64>( _last_frame.duration * 1.0e6f ) );
+	_frame_histogram.end_frame();
+	for ( ProfileResult& result : _results )
+	{
+		result.histogram.end_frame();
+	}
 
+	//	Record timelines
 	const float profile_time = get_profile_time() * 0.001f;
-	for ( auto& pair : _results )
+	for ( uint32 scope_id = 0; scope_id < _results.size(); scope_id++ )
 	{
-		auto itr = _timelines.find( pair.first );
+		const ProfileResult& result = _results[scope_id];
+		if ( result.total_calls == 0 ) continue;
+
+		auto itr = _timelines.find( scope_id );
 		if ( itr == _timelines.end() )
 		{
-			itr = _timelines.emplace( pair.first, ImGui::Extra::ScrollingBuffer<Vec2>( TIMELINE_DATA_SIZE ) ).first;
+			itr = _timelines.emplace( scope_id, ImGui::Extra::ScrollingBuffer<Vec2>( TIMELINE_DATA_SIZE ) ).first;
 		}
 
 		itr->second.add_point(
 			Vec2 {
 				profile_time,
-				pair.second.non_consumed_time
-				//updater->get_unscaled_delta_time() * 1000.0f
+				result.non_consumed_time
 			}
 		);
 	}
@@ -165,6 +396,151 @@ void Profiler::update()
 	consume_results();
 }
 
+void Profiler::start_trace( const int frames_count, rconst_str path )
+{
+	if ( !is_profiling() )
+	{
+		start();
+	}
+
+	_trace = std::make_unique<ProfileTrace>( frames_count, _last_update_time );
+	_trace_path = path;
+	Logger::info( "Profiler: Tracing %d frames", frames_count );
+}
+
+void Profiler::stop_trace()
+{
+	if ( _trace == nullptr ) return;
+
+	std::vector<std::string> thread_names {};
+	thread_names.reserve( _last_frame.threads.size() );
+	for ( const ProfileThreadTree& tree : _last_frame.threads )
+	{
+		thread_names.push_back( tree.thread_name );
+	}
+
+	_trace->write( _trace_path, thread_names );
+	_trace.reset();
+}
+
+bool Profiler::is_tracing() const
+{
+	return _trace != nullptr;
+}
+
+void Profiler::_collect_thread( const uint32 thread_index, ProfileThreadBuffer& buffer, ThreadState& state, ProfileThreadTree& tree )
+{
+	tree.nodes.clear();
+	tree.nodes.emplace_back().scope_id = INVALID_SCOPE_ID;
+
+	//	Re-open the scopes left open by the previous frame
+	int current_index = 0;
+	for ( OpenScope& scope : state.stack )
+	{
+		current_index = find_or_add_child( tree, current_index, scope.scope_id );
+		scope.node_index = current_index;
+	}
+
+	const bool is_profiling = this->is_profiling();
+	uint32 read_index = buffer.read_index.load( std::memory_order_relaxed );
+	const uint32 write_index = buffer.write_index.load( std::memory_order_acquire );
+	for ( ; read_index != write_index; read_index++ )
+	{
+		const ProfileEvent& event = buffer.events[read_index & ProfileThreadBuffer::MASK];
+		const int64 event_time = _to_time( event.ticks );
+		if ( event.is_begin )
+		{
+			current_index = find_or_add_child( tree, current_index, event.scope_id );
+			state.stack.push_back( OpenScope { event.scope_id, event_time, current_index } );
+			continue;
+		}
+
+		//	Ignore unmatched ends
+		if ( state.stack.empty() || state.stack.back().scope_id != event.scope_id ) continue;
+
+		const OpenScope scope = state.stack.back();
+		state.stack.pop_back();
+		current_index = state.stack.empty() ? 0 : state.stack.back().node_index;
+
+		const int64 duration = math::max( event_time - scope.begin_time, int64 { 0 } );
+		const float time = duration * 1.0e-6f;
+		ProfileNode& node = tree.nodes[scope.node_index];
+		node.inclusive_time += time;
+		node.calls++;
+
+		if ( _trace != nullptr )
+		{
+			_trace->add_scope( thread_index, event.scope_id, scope.begin_time, event_time );
+		}
+
+		if ( !is_profiling || event.scope_id >= _results.size() ) continue;
+
+		ProfileResult& result = _results[event.scope_id];
+		result.time = time;
+		result.max_time = std::max( result.max_time, time );
+		result.min_time = std::min( result.min_time, time );
+		result.total_time += time;
+		result.non_consumed_time += time;
+		result.total_calls++;
+		result.non_consumed_calls++;
+		result.histogram.record( static_cast<uint64>( duration ) );
+	}
+	buffer.read_index.store( read_index, std::memory_order_release );
+
+	_compute_self_times( tree );
+}
+
+void Profiler::_calibrate_clock()
+{
+	//	Wait for enough time to get a precise frequency
+	const uint64 ticks = read_ticks();
+	const int64 time = get_time_ns();
+	if ( time - _base_time < 1'000'000 || ticks <= _base_ticks ) return;
+
+	_nanoseconds_per_tick = static_cast<double>( time - _base_time ) / static_cast<double>( ticks - _base_ticks );
+}
+
+int64 Profiler::_to_time( const uint64 ticks ) const
+{
+	//	Ticks may precede the base
+	const int64 delta_ticks = static_cast<int64>( ticks - _base_ticks );
+	return _base_time + static_cast<int64>( delta_ticks * _nanoseconds_per_tick );
+}
+
+void Profiler::_compute_self_times( ProfileThreadTree& tree )
+{
+	//	Children are always stored after their parent
+	for ( std::size_t i = 1; i < tree.nodes.size(); i++ )
+	{
+		ProfileNode& node = tree.nodes[i];
+		node.self_time += node.inclusive_time;
+
+		ProfileNode& parent = tree.nodes[node.parent];
+		if ( node.parent == 0 )
+		{
+			parent.inclusive_time += node.inclusive_time;
+		}
+		else
+		{
+			parent.self_time -= node.inclusive_time;
+		}
+	}
+
+	const bool is_profiling = this->is_profiling();
+	for ( std::size_t i = 1; i < tree.nodes.size(); i++ )
+	{
+		//	Scopes left open may end after their children
+		ProfileNode& node = tree.nodes[i];
+		node.self_time = std::max( 0.0f, node.self_time );
+
+		if ( !is_profiling || node.scope_id >= _results.size() ) continue;
+
+		ProfileResult& result = _results[node.scope_id];
+		result.total_self_time += node.self_time;
+		result.non_consumed_self_time += node.self_time;
+	}
+}
+
 struct TimelineImData
 {
 	bool is_hidden = false;
@@ -224,9 +600,165 @@ static void populate_memory_category_result_in_table(
 }
 #endif
 
+constexpr float PERCENTILES[] { 0.50f, 0.90f, 0.99f, 0.999f };
+
+/*
+ * Add the row of the percentiles of the histogram.
+ */
+static void populate_percentiles_in_table( const char* name, const SlidingTimeHistogram& histogram )
+{
+	ImGui::TableNextRow( ImGuiTableRowFlags_None );
+
+	//	Name
+	ImGui::TableNextColumn();
+	ImGui::TextUnformatted( name );
+
+	//	Samples
+	ImGui::TableNextColumn();
+	ImGui::Text( "%d", histogram.get_count() );
+
+	//	Percentiles
+	for ( const float percentile : PERCENTILES )
+	{
+		ImGui::TableNextColumn();
+		ImGui::Text( "%.3fms", histogram.get_percentile( percentile ) );
+	}
+}
+
+/*
+ * Add the row of the node, and of its children when expanded.
+ */
+static void populate_profile_node_in_table( const ProfileThreadTree& tree, const int node_index, const float frame_time )
+{
+	const ProfileNode& node = tree.nodes[node_index];
+	const bool is_root = node_index == 0;
+	const bool is_leaf = node.first_child == INDEX_NONE;
+
+	ImGui::TableNextRow( ImGuiTableRowFlags_None );
+
+	//	Name
+	ImGui::TableNextColumn();
+	ImGuiTreeNodeFlags tree_flags = ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_DefaultOpen;
+	if ( is_leaf )
+	{
+		tree_flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+	}
+	const char* name = is_root ? tree.thread_name.c_str() : Profiler::get_scope_name( node.scope_id );
+	const bool is_open = ImGui::TreeNodeEx( reinterpret_cast<void*>( static_cast<intptr_t>( node_index ) ), tree_flags, "%s", name );
+
+	//	Inclusive Time
+	ImGui::TableNextColumn();
+	ImGui::Text( "%.3fms", node.inclusive_time );
+
+	//	Self Time
+	ImGui::TableNextColumn();
+	if ( !is_root )
+	{
+		ImGui::Text( "%.3fms", node.self_time );
+	}
+
+	//	Calls
+	ImGui::TableNextColumn();
+	if ( !is_root )
+	{
+		ImGui::Text( "%d", node.calls );
+	}
+
+	//	Usage
+	const float usage = frame_time > 0.0f ? node.inclusive_time / frame_time : 0.0f;
+	ImGui::TableNextColumn();
+	ImGui::Text( "%.1f%%", usage * 100.0f );
+
+	if ( !is_open || is_leaf ) return;
+
+	for ( int index = node.first_child; index != INDEX_NONE; index = tree.nodes[index].next_sibling )
+	{
+		populate_profile_node_in_table( tree, index, frame_time );
+	}
+	ImGui::TreePop();
+}
+
+/*
+ * Draw the children of the node in the given horizontal range, then
+ * recursively their own children in the next rows.
+ */
+static void draw_flame_graph_nodes(
+	ImDrawList* draw_list,
+	const ProfileThreadTree& tree,
+	const int parent_index,
+	const ImVec2& origin,
+	float x,
+	const int depth,
+	const float pixels_per_ms,
+	const float row_height
+)
+{
+	for ( int index = tree.nodes[parent_index].first_child; index != INDEX_NONE; index = tree.nodes[index].next_sibling )
+	{
+		const ProfileNode& node = tree.nodes[index];
+		const float width = node.inclusive_time * pixels_per_ms;
+
+		//	Skip nodes too small to be seen, along with their children
+		if ( width >= 1.0f )
+		{
+			const ImVec2 min { origin.x + x, origin.y + depth * row_height };
+			const ImVec2 max { min.x + width - 1.0f, min.y + row_height - 1.0f };
+
+			//	Color by scope, using the golden ratio to spread hues
+			const float hue = math::fmod( node.scope_id * 0.618034f, 1.0f );
+			draw_list->AddRectFilled( min, max, ImColor::HSV( hue, 0.5f, 0.75f ) );
+
+			const char* name = Profiler::get_scope_name( node.scope_id );
+			const ImVec4 clip_rect { min.x, min.y, max.x, max.y };
+			draw_list->AddText( nullptr, 0.0f, ImVec2 { min.x + 2.0f, min.y }, IM_COL32_WHITE, name, nullptr, 0.0f, &clip_rect );
+
+			if ( ImGui::IsMouseHoveringRect( min, max ) )
+			{
+				ImGui::SetTooltip(
+					"%s\nInclusive: %.3fms\nSelf: %.3fms\nCalls: %d",
+					name, node.inclusive_time, node.self_time, node.calls
+				);
+			}
+
+			draw_flame_graph_nodes( draw_list, tree, index, origin, x, depth + 1, pixels_per_ms, row_height );
+		}
+
+		x += width;
+	}
+}
+
+/*
+ * Draw the call tree as a flame graph, scaled to the frame time.
+ */
+static void populate_flame_graph( const ProfileThreadTree& tree, const float frame_time )
+{
+	//	Compute the depth of the tree, parents being stored before their children
+	FrameVector<int> depths( tree.nodes.size(), 0, Engine::instance().get_frame_arena() );
+	int max_depth = 0;
+	for ( std::size_t i = 1; i < tree.nodes.size(); i++ )
+	{
+		depths[i] = depths[tree.nodes[i].parent] + 1;
+		max_depth = std::max( max_depth, depths[i] );
+	}
+
+	const float row_height = ImGui::GetTextLineHeightWithSpacing();
+	const float width = ImGui::GetContentRegionAvail().x;
+	const float scale_time = std::max( frame_time, tree.nodes[0].inclusive_time );
+	if ( scale_time <= 0.0f || width <= 0.0f ) return;
+
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImGui::Dummy( ImVec2 { width, max_depth * row_height } );
+
+	draw_flame_graph_nodes(
+		ImGui::GetWindowDrawList(),
+		tree, 0,
+		origin, 0.0f, 0,
+		width / scale_time, row_height
+	);
+}
+
 void Profiler::populate_imgui()
 {
-	const auto& results = get_results();
 	const float profile_time_ms = get_profile_time();
 	const float profile_time_seconds = profile_time_ms * 0.001f;
 
@@ -262,6 +794,20 @@ void Profiler::populate_imgui()
 			*string::bytes_to_str( memory_global_result.new_min_bytes ),
 			*string::bytes_to_str( memory_global_result.new_max_bytes )
 		);
+		ImGui::Spacing();
+
+		//	Steady frames shouldn't allocate
+		const MemoryFrameProfileResult& memory_frame_result = MemoryProfiler::get_frame_result();
+		const ImVec4 frame_allocations_color = memory_frame_result.allocations_count > 0
+			? ImVec4 { 1.0f, 0.6f, 0.2f, 1.0f }
+			: ImGui::GetStyleColorVec4( ImGuiCol_Text );
+		ImGui::TextColored(
+			frame_allocations_color,
+			"Frame Allocations: %d (%s)",
+			static_cast<int>( memory_frame_result.allocations_count ),
+			*string::bytes_to_str( memory_frame_result.allocated_bytes )
+		);
+		ImGui::Text( "Frame Deallocations: %d", static_cast<int>( memory_frame_result.deallocations_count ) );
 
 		ImGui::TreePop();
 	}
@@ -438,111 +984,287 @@ void Profiler::populate_imgui()
 
 		ImGui::TreePop();
 	}
-#else
-	ImGui::TextWrapped( "Compile with ENABLE_MEMORY_PROFILER to access this feature." );
-#endif
 
-	ImGui::Spacing();
-	ImGui::SeparatorText( "Time" );
-	if ( ImGui::TreeNode( "Results" ) )
+	if ( ImGui::TreeNode( "Arenas" ) )
 	{
-		//	TODO: Add sorting
 		ImGuiTableFlags table_flags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
 		table_flags |= ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
 		table_flags |= ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable;
-		//table_flags |= ImGuiTableFlags_SizingFixedFit;
 
 		constexpr const char* COLUMN_NAMES[] {
 			"Name",
-			"Last Time", "Min. Time", "Avg. Time", "Max. Time",
-			"Frame Time", "Frame Calls",
-			"Total Calls",
-			"Usage",
+			"Capacity", "Used Bytes", "High-Water Mark", "Overflow Bytes",
 		};
 		constexpr int COLUMNS_AMOUNT = IM_ARRAYSIZE( COLUMN_NAMES );
-		constexpr ImVec2 TABLE_SIZE { 0.0f, 250.0f };
-		if ( ImGui::BeginTable( "suprengine_profiler_results", COLUMNS_AMOUNT, table_flags, TABLE_SIZE ) )
+		constexpr ImVec2 TABLE_SIZE { 0.0f, 100.0f };
+		if ( ImGui::BeginTable( "suprengine_memory_profiler_arenas", COLUMNS_AMOUNT, table_flags, TABLE_SIZE ) )
 		{
 			//	Setup first column
 			ImGui::TableSetupColumn( COLUMN_NAMES[0], ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_NoReorder );
 
 			//	Setup remaining columns
-			ImGuiTableColumnFlags column_flags = ImGuiTableColumnFlags_WidthFixed;
 			for ( int i = 1; i < COLUMNS_AMOUNT; i++ )
 			{
-				ImGui::TableSetupColumn( COLUMN_NAMES[i], column_flags );
+				ImGui::TableSetupColumn( COLUMN_NAMES[i], ImGuiTableColumnFlags_WidthFixed );
 			}
 
 			//	Freeze headers and first column
 			ImGui::TableSetupScrollFreeze( 1, 1 );
-
-			//	Draw angled headers if needed
-			if ( column_flags & ImGuiTableColumnFlags_AngledHeader )
-			{
-				ImGui::TableAngledHeadersRow();
-			}
 			ImGui::TableHeadersRow();
 
 			//	Draw results
-			const ImVec4 default_row_color = ImGui::GetStyleColorVec4( ImGuiCol_TableRowBg );
-			for ( const auto& result_pair : results )
+			for ( const auto& [name, result] : MemoryProfiler::get_arenas_results() )
 			{
-				const char* name = result_pair.first;
-				const ProfileResult& result = result_pair.second;
-
 				ImGui::TableNextRow( ImGuiTableRowFlags_None );
 
 				//	Name
 				ImGui::TableNextColumn();
 				ImGui::TextUnformatted( name );
 
-				//	Last Time
+				//	Capacity
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.3fms", result.time );
+				ImGui::Text( "%s", *string::bytes_to_str( result.capacity ) );
 
-				//	Min. Time
+				//	Used Bytes
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.3fms", result.min_time );
+				ImGui::Text( "%s", *string::bytes_to_str( result.used_bytes ) );
 
-				//	Avg. Time
+				//	High-Water Mark
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.3fms", result.total_time / result.total_calls );
+				ImGui::Text( "%s", *string::bytes_to_str( result.high_water_mark ) );
 
-				//	Max. Time
+				//	Overflow Bytes, meaning the capacity is too small
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.3fms", result.max_time );
+				if ( result.overflow_bytes > 0 )
+				{
+					ImGui::TextColored( ImVec4 { 1.0f, 0.6f, 0.2f, 1.0f }, "%s", *string::bytes_to_str( result.overflow_bytes ) );
+				}
+				else
+				{
+					ImGui::TextUnformatted( "0" );
+				}
+			}
 
-				//	Frame Time
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+
+	if ( ImGui::TreeNode( "Allocation Sites" ) )
+	{
+		//	Sample the callstacks of allocations
+		if ( MemoryProfiler::is_tracking_sites() )
+		{
+			if ( ImGui::Button( "Stop Tracking" ) )
+			{
+				MemoryProfiler::stop_sites_tracking();
+			}
+		}
+		else
+		{
+			ImGui::SetNextItemWidth( 100.0f );
+			ImGui::InputInt( "Sampling Rate", &_sites_sampling_rate );
+			_sites_sampling_rate = math::max( 1, _sites_sampling_rate );
+			ImGui::SameLine();
+			if ( ImGui::Button( "Start Tracking" ) )
+			{
+				MemoryProfiler::start_sites_tracking( static_cast<uint32>( _sites_sampling_rate ) );
+			}
+		}
+
+		ImGui::SetNextItemWidth( 100.0f );
+		ImGui::InputInt( "Sites", &_sites_count );
+		_sites_count = math::max( 1, _sites_count );
+		ImGui::SameLine();
+		if ( ImGui::Button( "Dump" ) )
+		{
+			MemoryProfiler::dump_top_allocation_sites( _sites_count );
+		}
+
+		ImGuiTableFlags table_flags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+		table_flags |= ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		table_flags |= ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable;
+
+		constexpr const char* COLUMN_NAMES[] {
+			"Site",
+			"Allocs/Frame", "Bytes/Frame", "Frames",
+		};
+		constexpr int COLUMNS_AMOUNT = IM_ARRAYSIZE( COLUMN_NAMES );
+		constexpr ImVec2 TABLE_SIZE { 0.0f, 200.0f };
+		if ( ImGui::BeginTable( "suprengine_memory_profiler_allocation_sites", COLUMNS_AMOUNT, table_flags, TABLE_SIZE ) )
+		{
+			//	Setup first column
+			ImGui::TableSetupColumn( COLUMN_NAMES[0], ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_NoReorder );
+
+			//	Setup remaining columns
+			for ( int i = 1; i < COLUMNS_AMOUNT; i++ )
+			{
+				ImGui::TableSetupColumn( COLUMN_NAMES[i], ImGuiTableColumnFlags_WidthFixed );
+			}
+
+			//	Freeze headers and first column
+			ImGui::TableSetupScrollFreeze( 1, 1 );
+			ImGui::TableHeadersRow();
+
+			//	Draw sites
+			const std::vector<MemoryAllocationSiteResult> sites = MemoryProfiler::get_top_allocation_sites( _sites_count );
+			for ( const MemoryAllocationSiteResult& site : sites )
+			{
+				ImGui::TableNextRow( ImGuiTableRowFlags_None );
+
+				//	Site, showing the whole callstack on hover
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.3fms", result.non_consumed_time );
+				ImGui::TextUnformatted( MemoryProfiler::get_symbol_name( site.callstack[0] ).c_str() );
+				if ( ImGui::IsItemHovered() )
+				{
+					ImGui::BeginTooltip();
+					for ( void* address : site.callstack )
+					{
+						ImGui::TextUnformatted( MemoryProfiler::get_symbol_name( address ).c_str() );
+					}
+					ImGui::EndTooltip();
+				}
 
-				//	Frame Calls
+				//	Allocs/Frame
 				ImGui::TableNextColumn();
-				ImGui::Text( "%d", result.non_consumed_calls );
+				ImGui::Text( "%.1f", site.allocations_per_frame );
 
-				//	Total Calls
+				//	Bytes/Frame
 				ImGui::TableNextColumn();
-				ImGui::Text( "%d", result.total_calls );
+				ImGui::Text( "%s", *string::bytes_to_str( static_cast<std::size_t>( site.bytes_per_frame ) ) );
 
-				//	Usage
-				float usage = result.total_time / profile_time_ms;
+				//	Frames
 				ImGui::TableNextColumn();
-				ImGui::Text( "%.1f%%", usage * 100.0f );
+				ImGui::Text( "%.0f%%", site.frames_ratio * 100.0f );
+			}
 
-				//	Set cell's background color depending on usage
-				constexpr ImVec4 MAX_USAGE_COLOR { 0.8f, 0.2f, 0.1f, 0.5f };
-				constexpr float MAX_USAGE_PERCENT = 60.0f;
-				constexpr float USAGE_COLOR_SCALE = 100.0f / MAX_USAGE_PERCENT;
-				ImGui::TableSetBgColor(
-					ImGuiTableBgTarget_RowBg0,
-					ImGui::GetColorU32(
-						ImLerp(
-							default_row_color,
-							MAX_USAGE_COLOR,
-							ImSaturate( usage * USAGE_COLOR_SCALE )
-						)
-					)
-				);
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+#else
+	ImGui::TextWrapped( "Compile with ENABLE_MEMORY_PROFILER to access this feature." );
+#endif
+
+	ImGui::Spacing();
+	ImGui::SeparatorText( "Time" );
+	//	Keep displaying the same frame while frozen, copied once on freeze
+	if ( ImGui::Checkbox( "Freeze Frame", &_is_frame_frozen ) && _is_frame_frozen )
+	{
+		_displayed_frame = _last_frame;
+	}
+	const ProfileFrame& displayed_frame = _is_frame_frozen ? _displayed_frame : _last_frame;
+	ImGui::SameLine();
+	ImGui::Text( "Frame Time: %.3fms", displayed_frame.duration );
+
+	//	Capture the next frames into a trace file
+	if ( is_tracing() )
+	{
+		ImGui::Text( "Tracing: %d/%d frames", _trace->get_captured_frames_count(), _trace->get_frames_count() );
+		ImGui::SameLine();
+		if ( ImGui::Button( "Stop Trace" ) )
+		{
+			stop_trace();
+		}
+	}
+	else
+	{
+		ImGui::SetNextItemWidth( 100.0f );
+		ImGui::InputInt( "Frames", &_trace_frames_count );
+		_trace_frames_count = math::max( 1, _trace_frames_count );
+		ImGui::SameLine();
+		if ( ImGui::Button( "Capture Trace" ) )
+		{
+			start_trace( _trace_frames_count, "profile-trace.json" );
+		}
+	}
+
+	const uint32 dropped_events_count = get_dropped_events_count();
+	if ( dropped_events_count > 0 )
+	{
+		ImGui::TextColored( ImVec4 { 1.0f, 0.6f, 0.2f, 1.0f }, "Dropped Events: %d", dropped_events_count );
+	}
+
+	if ( ImGui::TreeNode( "Percentiles" ) )
+	{
+		ImGuiTableFlags table_flags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+		table_flags |= ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+		table_flags |= ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable;
+
+		constexpr const char* COLUMN_NAMES[] {
+			"Name", "Samples",
+			"p50", "p90", "p99", "p99.9",
+		};
+		constexpr int COLUMNS_AMOUNT = IM_ARRAYSIZE( COLUMN_NAMES );
+		static_assert( COLUMNS_AMOUNT == IM_ARRAYSIZE( PERCENTILES ) + 2 );
+		constexpr ImVec2 TABLE_SIZE { 0.0f, 200.0f };
+		if ( ImGui::BeginTable( "suprengine_profiler_percentiles", COLUMNS_AMOUNT, table_flags, TABLE_SIZE ) )
+		{
+			//	Setup first column
+			ImGui::TableSetupColumn( COLUMN_NAMES[0], ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_NoReorder );
+
+			//	Setup remaining columns
+			for ( int i = 1; i < COLUMNS_AMOUNT; i++ )
+			{
+				ImGui::TableSetupColumn( COLUMN_NAMES[i], ImGuiTableColumnFlags_WidthFixed );
+			}
+
+			//	Freeze headers and first column
+			ImGui::TableSetupScrollFreeze( 1, 1 );
+			ImGui::TableHeadersRow();
+
+			//	Draw the frame, then scopes recently called
+			populate_percentiles_in_table( "Frame", _frame_histogram );
+			for ( const ProfileResult& result : _results )
+			{
+				if ( result.histogram.get_count() == 0 ) continue;
+
+				populate_percentiles_in_table( result.name, result.histogram );
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+
+	ImGui::SetNextItemOpen( true, ImGuiCond_FirstUseEver );
+	if ( ImGui::TreeNode( "Call Tree" ) )
+	{
+		ImGuiTableFlags table_flags = ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+		table_flags |= ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH | ImGuiTableFlags_RowBg;
+		table_flags |= ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable;
+
+		constexpr const char* COLUMN_NAMES[] {
+			"Name",
+			"Inclusive Time", "Self Time", "Calls",
+			"Usage",
+		};
+		constexpr int COLUMNS_AMOUNT = IM_ARRAYSIZE( COLUMN_NAMES );
+		constexpr ImVec2 TABLE_SIZE { 0.0f, 250.0f };
+		if ( ImGui::BeginTable( "suprengine_profiler_call_tree", COLUMNS_AMOUNT, table_flags, TABLE_SIZE ) )
+		{
+			//	Setup first column
+			ImGui::TableSetupColumn( COLUMN_NAMES[0], ImGuiTableColumnFlags_NoHide | ImGuiTableColumnFlags_NoReorder );
+
+			//	Setup remaining columns
+			for ( int i = 1; i < COLUMNS_AMOUNT; i++ )
+			{
+				ImGui::TableSetupColumn( COLUMN_NAMES[i], ImGuiTableColumnFlags_WidthFixed );
+			}
+
+			//	Freeze headers and first column
+			ImGui::TableSetupScrollFreeze( 1, 1 );
+			ImGui::TableHeadersRow();
+
+			//	Draw a tree per thread
+			for ( const ProfileThreadTree& tree : displayed_frame.threads )
+			{
+				if ( tree.nodes.size() <= 1 ) continue;
+
+				populate_profile_node_in_table( tree, 0, displayed_frame.duration );
 			}
 
 			ImGui::EndTable();
@@ -551,6 +1273,20 @@ void Profiler::populate_imgui()
 		ImGui::TreePop();
 	}
 
+	ImGui::SetNextItemOpen( true, ImGuiCond_FirstUseEver );
+	if ( ImGui::TreeNode( "Flame Graph" ) )
+	{
+		for ( const ProfileThreadTree& tree : displayed_frame.threads )
+		{
+			if ( tree.nodes.size() <= 1 ) continue;
+
+			ImGui::TextUnformatted( tree.thread_name.c_str() );
+			populate_flame_graph( tree, displayed_frame.duration );
+		}
+
+		ImGui::TreePop();
+	}
+
 	ImGui::SetNextItemOpen( true, ImGuiCond_FirstUseEver );
 	if ( ImGui::TreeNode( "Timelines" ) )
 	{
@@ -570,11 +1306,11 @@ void Profiler::populate_imgui()
 			ImPlot::SetupLegend( ImPlotLocation_West, ImPlotLegendFlags_Outside );
 
 			//	Draw timelines
-			std::vector<TimelineImData> timelines_data {};
+			FrameVector<TimelineImData> timelines_data( engine.get_frame_arena() );
 			timelines_data.reserve( _timelines.size() );
 			for ( auto& pair : _timelines )
 			{
-				const char* name = pair.first;
+				const char* name = get_scope_name( pair.first );
 				auto& timeline = pair.second;
 
 				int timeline_size = static_cast<int>( timeline.data.size() );
@@ -633,7 +1369,7 @@ void Profiler::populate_imgui()
 						if ( pos.y < mouse_pos.y ) break;
 
 						//	We have a potential winner, let's see the other timelines
-						hovered_timeline_name = pair.first;
+						hovered_timeline_name = get_scope_name( pair.first );
 						hovered_timeline_pos.x = pos.x;
 						hovered_timeline_pos.y = pos.y;
 						hovered_timeline_id = id;
@@ -712,7 +1448,29 @@ float Profiler::get_profile_time() const
 	return _timer.get_time();
 }
 
-const Profiler::ProfileResultsMap& Profiler::get_results() const
+const std::vector<ProfileResult>& Profiler::get_results() const
 {
 	return _results;
+}
+
+const ProfileFrame& Profiler::get_last_frame() const
+{
+	return _last_frame;
+}
+
+const SlidingTimeHistogram& Profiler::get_frame_histogram() const
+{
+	return _frame_histogram;
+}
+
+uint32 Profiler::get_dropped_events_count() const
+{
+	std::lock_guard lock( buffers_mutex );
+
+	uint32 count = 0;
+	for ( const std::unique_ptr<ProfileThreadBuffer>& buffer : buffers )
+	{
+		count += buffer->dropped_events_count.load( std::memory_order_relaxed );
+	}
+	return count;
 }
\ No newline at end of file
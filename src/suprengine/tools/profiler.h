@@ -3,38 +3,123 @@
 #include <suprengine/math/math.h>
 #include <suprengine/math/vec2.h>
 
+#include <suprengine/tools/profile-trace.h>
+#include <suprengine/tools/time-histogram.h>
+
 #include <suprengine/utils/imgui/imgui-extra.h>
+#include <suprengine/utils/flat-hash-map.h>
 #include <suprengine/utils/usings.h>
 
 #include <chrono>
-#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
-#define PROFILE_SCOPE( name ) ProfileTimer _profile_timer##__LINE__( name )
+/*
+ * Profile the enclosing scope under the given name, which must be
+ * a string literal. The scope is registered once per call site.
+ * Compiled out without ENABLE_PROFILER.
+ */
+#ifdef ENABLE_PROFILER
+#define PROFILE_SCOPE( name ) ProfileScope SUPRENGINE_CONCAT( _profile_scope, __LINE__ )(	\
+	[] { static const uint32 scope_id = Profiler::register_scope( name ); return scope_id; }() )
+#else
+#define PROFILE_SCOPE( name )
+#endif
 
 namespace suprengine
 {
 	namespace chrono = std::chrono;
 
 	class Engine;
+	struct ProfileThreadBuffer;
 
+	/*
+	 * Statistics of a profiled scope, aggregated over all threads.
+	 * Times are in milliseconds.
+	 */
 	struct ProfileResult
 	{
+		const char* name = nullptr;
+
 		float time = 0.0f;
 		float min_time = math::PLUS_INFINITY;
 		float max_time = math::NEG_INFINITY;
 		float total_time = 0.0f;
 		float non_consumed_time = 0.0f;
+		/*
+		 * Time spent in the scope itself, excluding its child scopes.
+		 */
+		float total_self_time = 0.0f;
+		float non_consumed_self_time = 0.0f;
 		uint32 total_calls = 0;
 		uint32 non_consumed_calls = 0;
+
+		/*
+		 * Distribution of the recent times, for percentiles.
+		 */
+		SlidingTimeHistogram histogram {};
+	};
+
+	/*
+	 * Node of a call tree, merging all calls of a scope under the same
+	 * parent path. Times are in milliseconds.
+	 */
+	struct ProfileNode
+	{
+		uint32 scope_id = 0;
+
+		int parent = INDEX_NONE;
+		int first_child = INDEX_NONE;
+		int next_sibling = INDEX_NONE;
+
+		uint32 calls = 0;
+		/*
+		 * Time spent in the scope, including its child scopes.
+		 */
+		float inclusive_time = 0.0f;
+		/*
+		 * Time spent in the scope itself, excluding its child scopes.
+		 */
+		float self_time = 0.0f;
+	};
+
+	/*
+	 * Call tree of a thread over a frame.
+	 */
+	struct ProfileThreadTree
+	{
+		std::string thread_name {};
+		/*
+		 * Nodes of the tree, the first one being the root, whose 
+		 * inclusive time is the sum of its children.
+		 */
+		std::vector<ProfileNode> nodes {};
+	};
+
+	/*
+	 * Call trees of all profiled threads over a frame.
+	 */
+	struct ProfileFrame
+	{
+		/*
+		 * Time between the collections of this frame and the previous one,
+		 * in milliseconds.
+		 */
+		float duration = 0.0f;
+		std::vector<ProfileThreadTree> threads {};
 	};
 
+	/*
+	 * Stopwatch measuring time in milliseconds.
+	 */
 	class ProfileTimer
 	{
 	public:
 		using TimePoint = chrono::steady_clock::time_point;
 
 	public:
-		ProfileTimer( const char* name, bool is_running = true, bool should_log = true );
+		ProfileTimer( const char* name, bool is_running = true );
 		~ProfileTimer();
 
 		void start();
@@ -53,26 +138,75 @@ namespace suprengine
 		float _total_time = 0.0f;
 
 		bool _is_running = false;
-		bool _should_log = true;
 	};
 
+	/*
+	 * Hierarchical profiler, thread-safe.
+	 *
+	 * Each thread records the begin and end events of its scopes into its
+	 * own lock-free buffer. At each update, the profiler collects the
+	 * events of all threads and rebuilds their call trees for the frame,
+	 * separating self time from inclusive time.
+	 *
+	 * Events are timed in raw ticks of the CPU timestamp counter on x86,
+	 * or of the steady clock otherwise, converted to time on collection
+	 * by calibrating ticks against the steady clock.
+	 *
+	 * Events are dropped, along with their child scopes, when a buffer is
+	 * full. Scopes still open at the end of a frame are accounted in the
+	 * frame they end in. Buffers live as long as the program, so
+	 * profiling short-lived threads should be avoided.
+	 */
 	class Profiler
 	{
 	public:
-		using ProfileResultsMap = std::map<const char*, ProfileResult>;
+		static constexpr uint32 INVALID_SCOPE_ID = ~0u;
 
 	public:
 		Profiler( bool is_running = true );
 
-		void add_result( const char* name, float time );
+		/*
+		 * Returns the unique identifier of the scope of given name,
+		 * registering it on first use.
+		 */
+		static uint32 register_scope( const char* name );
+		static const char* get_scope_name( uint32 scope_id );
+
+		/*
+		 * Record the begin of a scope on the calling thread.
+		 * Returns whenever the end must be recorded.
+		 */
+		static bool begin_scope( uint32 scope_id );
+		static void end_scope( uint32 scope_id );
+
+		/*
+		 * Name the calling thread in the call trees.
+		 */
+		static void set_thread_name( rconst_str name );
+
 		void consume_results();
 		void clear();
 
 		void start();
 		void stop();
 
+		/*
+		 * Collect the recorded events into the call trees of the frame.
+		 * Called by the engine at the end of each frame, while no job runs.
+		 */
 		void update();
 
+		/*
+		 * Capture the scopes of the next frames into a trace, written at 
+		 * the given path once finished. Starts profiling if needed.
+		 */
+		void start_trace( int frames_count, rconst_str path );
+		/*
+		 * Stop capturing, writing the frames captured so far.
+		 */
+		void stop_trace();
+		bool is_tracing() const;
+
 		void populate_imgui();
 
 		bool is_profiling() const;
@@ -81,16 +215,104 @@ namespace suprengine
 		 */
 		float get_profile_time() const;
 
-		const ProfileResultsMap& get_results() const;
+		/*
+		 * Returns the results of all registered scopes, indexed by their
+		 * identifier. Scopes not called since the last clear have no calls.
+		 */
+		const std::vector<ProfileResult>& get_results() const;
+		/*
+		 * Returns the call trees of the last collected frame.
+		 */
+		const ProfileFrame& get_last_frame() const;
+		/*
+		 * Returns the distribution of the recent frame times.
+		 */
+		const SlidingTimeHistogram& get_frame_histogram() const;
+		/*
+		 * Returns the amount of events dropped by full thread buffers.
+		 */
+		uint32 get_dropped_events_count() const;
+
+	private:
+		struct OpenScope
+		{
+			uint32 scope_id = 0;
+			int64 begin_time = 0;
+			int node_index = 0;
+		};
+
+		/*
+		 * Collection state of a thread, persisting across frames.
+		 */
+		struct ThreadState
+		{
+			std::vector<OpenScope> stack {};
+		};
+
+	private:
+		void _collect_thread( uint32 thread_index, ProfileThreadBuffer& buffer, ThreadState& state, ProfileThreadTree& tree );
+		void _compute_self_times( ProfileThreadTree& tree );
+
+		void _calibrate_clock();
+		/*
+		 * Returns the steady clock time, in nanoseconds, of the given ticks.
+		 */
+		int64 _to_time( uint64 ticks ) const;
 
 	private:
-		ProfileResultsMap _results {};
+		std::vector<ProfileResult> _results {};
+
+		ProfileFrame _last_frame {};
+		SlidingTimeHistogram _frame_histogram {};
+		ProfileFrame _displayed_frame {};
+		bool _is_frame_frozen = false;
+		int64 _last_update_time = 0;
+
+		/*
+		 * Reference point of the ticks calibration.
+		 */
+		uint64 _base_ticks = 0;
+		int64 _base_time = 0;
+		double _nanoseconds_per_tick = 1.0;
+
+		std::vector<ThreadState> _threads_states {};
+
+		std::unique_ptr<ProfileTrace> _trace = nullptr;
+		std::string _trace_path {};
+		int _trace_frames_count = 300;
+
+		int _sites_sampling_rate = 16;
+		int _sites_count = 10;
 
 		/*
 		 * Timer to compute the total profile time
 		 */
 		ProfileTimer _timer;
 
-		std::map<const char*, ImGui::Extra::ScrollingBuffer<Vec2>> _timelines;
+		FlatHashMap<uint32, ImGui::Extra::ScrollingBuffer<Vec2>> _timelines;
+	};
+
+	/*
+	 * Records the begin and end events of a scope into the profiler.
+	 * Use PROFILE_SCOPE instead of constructing it directly.
+	 */
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope( const uint32 scope_id )
+			: _scope_id( scope_id ), _is_recording( Profiler::begin_scope( scope_id ) ) {}
+		~ProfileScope()
+		{
+			if ( !_is_recording ) return;
+
+			Profiler::end_scope( _scope_id );
+		}
+
+		ProfileScope( const ProfileScope& ) = delete;
+		ProfileScope& operator=( const ProfileScope& ) = delete;
+
+	private:
+		uint32 _scope_id = 0;
+		bool _is_recording = false;
 	};
 }
\ No newline at end of file
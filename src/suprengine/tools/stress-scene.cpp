@@ -0,0 +1,261 @@
+#include "stress-scene.h"
+
+#include <suprengine/core/assets.h>
+#include <suprengine/core/engine.h>
+
+#include <suprengine/components/colliders/box-collider.h>
+#include <suprengine/components/colliders/sphere-collider.h>
+#include <suprengine/components/renderers/model-renderer.hpp>
+#include <suprengine/components/lifetime-component.h>
+
+#include <suprengine/utils/logger.h>
+#include <suprengine/utils/random.h>
+
+#include <algorithm>
+
+using namespace suprengine;
+
+namespace chrono = std::chrono;
+
+/*
+ * Reflect the velocity on an axis when the location leaves the bounds.
+ */
+static void bounce( float& location, float& velocity, const float min, const float max )
+{
+	if ( location < min )
+	{
+		location = min;
+		velocity = math::abs( velocity );
+	}
+	else if ( location > max )
+	{
+		location = max;
+		velocity = -math::abs( velocity );
+	}
+}
+
+StressMover::StressMover( const Vec3& velocity, const Box& bounds )
+	: velocity( velocity ), bounds( bounds )
+{}
+
+void StressMover::update( const float dt )
+{
+	Vec3 location = transform->location + velocity * dt;
+	bounce( location.x, velocity.x, bounds.min.x, bounds.max.x );
+	bounce( location.y, velocity.y, bounds.min.y, bounds.max.y );
+	bounce( location.z, velocity.z, bounds.min.z, bounds.max.z );
+
+	transform->set_location( location );
+}
+
+StressScene::StressScene( const StressSceneSettings& settings )
+	: _settings( settings )
+{}
+
+void StressScene::init()
+{
+	random::seed( _settings.seed );
+
+	_target_entities_count = _settings.scaling_steps.empty()
+		? _settings.entities_count
+		: _settings.scaling_steps[0];
+
+	//	Setup camera overlooking the bounds
+	Engine& engine = Engine::instance();
+	SharedPtr<Entity> camera_owner = engine.create_entity<Entity>();
+	camera_owner->transform->set_location( _settings.bounds.max * 1.5f );
+	camera_owner->transform->look_at( _settings.bounds.get_center() );
+	SharedPtr<Camera> camera = camera_owner->create_component<Camera>( CameraProjectionSettings {} );
+	camera->set_active();
+
+	_update_population( 0.0f );
+	_last_update_time = chrono::steady_clock::now();
+
+	Logger::info( "StressScene: Spawned %d entities with seed %u", get_entities_count(), _settings.seed );
+}
+
+void StressScene::update( const float dt )
+{
+	_remove_invalid_entities();
+	_update_scaling();
+	_update_population( dt );
+}
+
+SharedPtr<Entity> StressScene::spawn_entity()
+{
+	Engine& engine = Engine::instance();
+
+	SharedPtr<Entity> entity = engine.create_entity<Entity>();
+	entity->transform->set_location( random::generate_location( _settings.bounds ) );
+	entity->transform->set_rotation( random::generate_rotation() );
+
+	//	Add colliders, matching the model's shape
+	bool is_sphere = random::generate_bool();
+	const float collider_roll = random::generate( 0.0f, 1.0f );
+	if ( collider_roll < _settings.sphere_collider_ratio )
+	{
+		entity->create_component<SphereCollider>( 1.0f );
+		is_sphere = true;
+	}
+	else if ( collider_roll < _settings.sphere_collider_ratio + _settings.box_collider_ratio )
+	{
+		entity->create_component<BoxCollider>( Box::half );
+		is_sphere = false;
+	}
+
+	if ( random::generate( 0.0f, 1.0f ) < _settings.model_renderer_ratio )
+	{
+		entity->create_component<ModelRenderer>(
+			Assets::get_model( is_sphere ? MESH_SPHERE : MESH_CUBE ),
+			SHADER_LIT_MESH,
+			random::generate_color()
+		);
+	}
+
+	if ( random::generate( 0.0f, 1.0f ) < _settings.mover_ratio )
+	{
+		const Vec3 velocity = random::generate_direction() * random::generate( _settings.move_speed_range );
+		entity->create_component<StressMover>( velocity, _settings.bounds );
+	}
+
+	if ( random::generate( 0.0f, 1.0f ) < _settings.lifetime_ratio )
+	{
+		SharedPtr<LifetimeComponent> lifetime = entity->create_component<LifetimeComponent>(
+			random::generate( _settings.lifetime_range ) );
+
+		//	Avoid a reference cycle by capturing a raw pointer, the component
+		//	being owned by the entity
+		Entity* owner = entity.get();
+		lifetime->on_time_out.listen( [owner] { owner->kill(); } );
+	}
+
+	_entities.push_back( entity );
+	return entity;
+}
+
+void StressScene::kill_random_entity()
+{
+	if ( _entities.empty() ) return;
+
+	const int index = random::generate( 0, static_cast<int>( _entities.size() ) - 1 );
+	_entities[index]->kill();
+
+	//	Swap-remove it
+	_entities[index] = _entities.back();
+	_entities.pop_back();
+}
+
+int StressScene::get_entities_count() const
+{
+	return static_cast<int>( _entities.size() );
+}
+
+bool StressScene::is_scaling_finished() const
+{
+	return _scaling_step_index >= static_cast<int>( _settings.scaling_steps.size() );
+}
+
+void StressScene::_remove_invalid_entities()
+{
+	const auto itr = std::remove_if( _entities.begin(), _entities.end(),
+		[]( const SharedPtr<Entity>& entity )
+		{
+			return entity->state == EntityState::Invalid;
+		}
+	);
+	_entities.erase( itr, _entities.end() );
+}
+
+void StressScene::_update_population( const float dt )
+{
+	//	Churn entities
+	_pending_kills += _settings.kills_per_second * dt;
+	while ( _pending_kills >= 1.0f )
+	{
+		kill_random_entity();
+		_pending_kills -= 1.0f;
+	}
+
+	//	Spawn up to the target, so spawning faster than killing doesn't grow
+	//	the population indefinitely
+	_pending_spawns += _settings.spawns_per_second * dt;
+	while ( _pending_spawns >= 1.0f )
+	{
+		if ( get_entities_count() < _target_entities_count )
+		{
+			spawn_entity();
+		}
+		_pending_spawns -= 1.0f;
+	}
+
+	//	Keep the population, replacing killed entities
+	while ( get_entities_count() < _target_entities_count )
+	{
+		spawn_entity();
+	}
+}
+
+void StressScene::_update_scaling()
+{
+	if ( is_scaling_finished() ) return;
+
+	const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	const float frame_time = chrono::duration<float, std::milli>( now - _last_update_time ).count();
+	_last_update_time = now;
+
+	//	Measure after warmup, letting the step's entities spawn
+	_step_frames_count++;
+	if ( _step_frames_count <= _settings.warmup_frames_per_step ) return;
+
+	_step_total_frame_time += frame_time;
+	_step_max_frame_time = math::max( _step_max_frame_time, frame_time );
+	if ( _step_frames_count < _settings.warmup_frames_per_step + _settings.frames_per_step ) return;
+
+	//	Record the step
+	StressScalingSample sample {};
+	sample.entities_count = get_entities_count();
+	sample.average_frame_time = _step_total_frame_time / _settings.frames_per_step;
+	sample.max_frame_time = _step_max_frame_time;
+	_scaling_samples.push_back( sample );
+
+	Logger::info( "StressScene: Measured %d entities: %.3fms average, %.3fms max",
+		sample.entities_count, sample.average_frame_time, sample.max_frame_time );
+
+	_step_frames_count = 0;
+	_step_total_frame_time = 0.0f;
+	_step_max_frame_time = 0.0f;
+	_scaling_step_index++;
+
+	if ( !is_scaling_finished() )
+	{
+		_target_entities_count = _settings.scaling_steps[_scaling_step_index];
+
+		//	Shrink the population for decreasing steps
+		while ( get_entities_count() > _target_entities_count )
+		{
+			kill_random_entity();
+		}
+		return;
+	}
+
+	_log_scaling_curve();
+
+	if ( _settings.should_quit_after_scaling )
+	{
+		Engine::instance().quit();
+	}
+}
+
+void StressScene::_log_scaling_curve() const
+{
+	Logger::info( "StressScene: Scaling curve (seed %u):", _settings.seed );
+	Logger::info( "%12s %14s %14s %16s", "Entities", "Average (ms)", "Max (ms)", "Per entity (us)" );
+	for ( const StressScalingSample& sample : _scaling_samples )
+	{
+		const float time_per_entity = sample.entities_count > 0
+			? sample.average_frame_time * 1000.0f / sample.entities_count
+			: 0.0f;
+		Logger::info( "%12d %14.3f %14.3f %16.4f",
+			sample.entities_count, sample.average_frame_time, sample.max_frame_time, time_per_entity );
+	}
+}
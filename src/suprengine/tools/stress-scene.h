@@ -0,0 +1,176 @@
+#pragma once
+
+#include <suprengine/core/scene.h>
+#include <suprengine/core/entity.h>
+
+#include <suprengine/math/box.h>
+#include <suprengine/math/vec2.h>
+
+#include <chrono>
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Parameters of a StressScene.
+	 *
+	 * Each ratio is the probability, between 0.0f and 1.0f, for a spawned
+	 * entity to get the matching component. An entity gets either a
+	 * sphere or a box collider from a single roll, so the sum of both
+	 * collider ratios shouldn't exceed 1.0f.
+	 */
+	struct StressSceneSettings
+	{
+		/*
+		 * Amount of entities to keep alive.
+		 */
+		int entities_count = 1000;
+		/*
+		 * Seed given to random::seed, so runs are reproducible.
+		 */
+		unsigned int seed = 0;
+
+		float model_renderer_ratio = 1.0f;
+		float sphere_collider_ratio = 0.5f;
+		float box_collider_ratio = 0.25f;
+		float lifetime_ratio = 0.0f;
+		float mover_ratio = 0.5f;
+
+		/*
+		 * Range of life time, in seconds, of entities having a LifetimeComponent.
+		 * Expired entities are replaced by new ones.
+		 */
+		Vec2 lifetime_range { 1.0f, 5.0f };
+		/*
+		 * Range of speed, in units per second, of moving entities.
+		 */
+		Vec2 move_speed_range { 1.0f, 10.0f };
+
+		/*
+		 * Amount of entities spawned and killed each second. Spawns are
+		 * skipped once the kept amount of entities is reached, so the
+		 * population never grows past it.
+		 */
+		float spawns_per_second = 0.0f;
+		float kills_per_second = 0.0f;
+
+		/*
+		 * Area in which entities are spawned and move.
+		 */
+		Box bounds { Vec3 { -50.0f, -50.0f, -50.0f }, Vec3 { 50.0f, 50.0f, 50.0f } };
+
+		/*
+		 * Amounts of entities to successively measure, replacing 
+		 * 'entities_count', in order to get a scaling curve.
+		 * Leave empty to keep 'entities_count' alive indefinitely.
+		 */
+		std::vector<int> scaling_steps {};
+		/*
+		 * Amount of frames to skip, then to measure, for each step.
+		 */
+		int warmup_frames_per_step = 30;
+		int frames_per_step = 120;
+		/*
+		 * Whenever the engine should quit once all steps are measured.
+		 */
+		bool should_quit_after_scaling = false;
+	};
+
+	/*
+	 * Measured frame times, in milliseconds, for an amount of entities.
+	 */
+	struct StressScalingSample
+	{
+		int entities_count = 0;
+
+		float average_frame_time = 0.0f;
+		float max_frame_time = 0.0f;
+	};
+
+	/*
+	 * Component moving its entity at a constant velocity, bouncing
+	 * inside the given bounds.
+	 */
+	class StressMover : public Component
+	{
+	public:
+		StressMover( const Vec3& velocity, const Box& bounds );
+
+		void update( float dt ) override;
+
+		const ComponentAccess* get_update_access() const override
+		{
+			static const ComponentAccess access =
+				ComponentAccess::of<StressMover>().write<Transform>();
+			return &access;
+		}
+
+	public:
+		Vec3 velocity = Vec3::zero;
+		Box bounds {};
+	};
+
+	/*
+	 * Scene spawning a configurable amount of entities with a mix of
+	 * engine components, in order to find how the engine scales.
+	 *
+	 * The population is kept at the configured amount of entities,
+	 * optionally churned by spawning and killing entities each second.
+	 * When scaling steps are given, the scene measures the frame times
+	 * for each amount of entities and logs the resulting curve.
+	 *
+	 * Frame times are measured between consecutive scene updates, so
+	 * the fixed timestep mode of the Updater should be disabled.
+	 */
+	class StressScene : public Scene
+	{
+	public:
+		StressScene( const StressSceneSettings& settings );
+
+		void init() override;
+		void update( float dt ) override;
+
+		/*
+		 * Spawn an entity with a random mix of components.
+		 */
+		SharedPtr<Entity> spawn_entity();
+		/*
+		 * Kill a random entity spawned by the scene.
+		 */
+		void kill_random_entity();
+
+		int get_entities_count() const;
+		/*
+		 * Returns whenever all scaling steps are measured.
+		 */
+		bool is_scaling_finished() const;
+		const std::vector<StressScalingSample>& get_scaling_samples() const { return _scaling_samples; }
+
+		const StressSceneSettings& get_settings() const { return _settings; }
+
+	private:
+		void _remove_invalid_entities();
+		void _update_population( float dt );
+		void _update_scaling();
+		void _log_scaling_curve() const;
+
+	private:
+		StressSceneSettings _settings {};
+
+		std::vector<SharedPtr<Entity>> _entities {};
+		int _target_entities_count = 0;
+
+		/*
+		 * Fractional amounts of entities left to spawn and kill.
+		 */
+		float _pending_spawns = 0.0f;
+		float _pending_kills = 0.0f;
+
+		std::vector<StressScalingSample> _scaling_samples {};
+		int _scaling_step_index = 0;
+		int _step_frames_count = 0;
+		float _step_total_frame_time = 0.0f;
+		float _step_max_frame_time = 0.0f;
+		std::chrono::steady_clock::time_point _last_update_time {};
+	};
+}
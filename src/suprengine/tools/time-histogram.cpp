@@ -0,0 +1,119 @@
+#include "time-histogram.h"
+
+#include <suprengine/math/math.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <bit>
+
+using namespace suprengine;
+
+void TimeHistogram::record( const uint64 time )
+{
+	_buckets[_get_bucket_index( time )]++;
+	_count++;
+}
+
+void TimeHistogram::clear()
+{
+	_buckets.fill( 0 );
+	_count = 0;
+}
+
+void TimeHistogram::add( const TimeHistogram& other )
+{
+	for ( int i = 0; i < BUCKETS_COUNT; i++ )
+	{
+		_buckets[i] += other._buckets[i];
+	}
+	_count += other._count;
+}
+
+void TimeHistogram::subtract( const TimeHistogram& other )
+{
+	ASSERT( _count >= other._count );
+
+	for ( int i = 0; i < BUCKETS_COUNT; i++ )
+	{
+		_buckets[i] -= other._buckets[i];
+	}
+	_count -= other._count;
+}
+
+float TimeHistogram::get_percentile( const float percentile ) const
+{
+	if ( _count == 0 ) return 0.0f;
+
+	//	Find the bucket of the nearest-rank duration
+	const uint32 rank = math::clamp(
+		static_cast<uint32>( math::ceil( _count * percentile ) ),
+		1u, _count
+	);
+	uint32 count = 0;
+	for ( int i = 0; i < BUCKETS_COUNT; i++ )
+	{
+		count += _buckets[i];
+		if ( count >= rank ) return _get_bucket_time( i ) * 1.0e-6f;
+	}
+
+	return _get_bucket_time( BUCKETS_COUNT - 1 ) * 1.0e-6f;
+}
+
+int TimeHistogram::_get_bucket_index( uint64 time )
+{
+	time = math::min( time, MAX_TIME );
+
+	//	Small durations are stored exactly
+	if ( time < SUB_BUCKETS_COUNT ) return static_cast<int>( time );
+
+	//	Keep the SUB_BUCKET_BITS bits following the highest one
+	const int shift = static_cast<int>( std::bit_width( time ) ) - 1 - SUB_BUCKET_BITS;
+	const int sub_bucket_index = static_cast<int>( time >> shift ) - SUB_BUCKETS_COUNT;
+	return ( shift + 1 ) * SUB_BUCKETS_COUNT + sub_bucket_index;
+}
+
+uint64 TimeHistogram::_get_bucket_time( const int index )
+{
+	if ( index < SUB_BUCKETS_COUNT ) return static_cast<uint64>( index );
+
+	const int shift = index / SUB_BUCKETS_COUNT - 1;
+	const uint64 sub_bucket_index = index % SUB_BUCKETS_COUNT;
+	const uint64 min_time = ( SUB_BUCKETS_COUNT + sub_bucket_index ) << shift;
+	return min_time + ( ( uint64 { 1 } << shift ) >> 1 );
+}
+
+SlidingTimeHistogram::SlidingTimeHistogram( const int frames_per_slot )
+	: _frames_per_slot( frames_per_slot )
+{}
+
+void SlidingTimeHistogram::record( const uint64 time )
+{
+	_slots[_current_slot].record( time );
+	_window.record( time );
+}
+
+void SlidingTimeHistogram::end_frame()
+{
+	_current_slot_frames++;
+	if ( _current_slot_frames < _frames_per_slot ) return;
+
+	//	Reuse the oldest slot
+	_current_slot = ( _current_slot + 1 ) % SLOTS_COUNT;
+	_current_slot_frames = 0;
+
+	TimeHistogram& slot = _slots[_current_slot];
+	_window.subtract( slot );
+	slot.clear();
+}
+
+void SlidingTimeHistogram::clear()
+{
+	for ( TimeHistogram& slot : _slots )
+	{
+		slot.clear();
+	}
+	_window.clear();
+
+	_current_slot = 0;
+	_current_slot_frames = 0;
+}
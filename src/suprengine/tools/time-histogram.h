@@ -0,0 +1,104 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <array>
+
+namespace suprengine
+{
+	/*
+	 * Fixed-memory histogram of durations, in the manner of HDR histograms.
+	 *
+	 * Durations are recorded in nanoseconds into buckets whose width grows
+	 * with their magnitude: each power of two is split into SUB_BUCKETS_COUNT
+	 * linear sub-buckets, bounding the relative error of reported values.
+	 * Durations above MAX_TIME are clamped into the last bucket.
+	 */
+	class TimeHistogram
+	{
+	public:
+		static constexpr int SUB_BUCKET_BITS = 4;
+		static constexpr int SUB_BUCKETS_COUNT = 1 << SUB_BUCKET_BITS;
+		/*
+		 * Amount of bits of the maximum duration, about 68 seconds.
+		 */
+		static constexpr int MAX_TIME_BITS = 36;
+		static constexpr uint64 MAX_TIME = ( uint64 { 1 } << MAX_TIME_BITS ) - 1;
+		static constexpr int BUCKETS_COUNT = SUB_BUCKETS_COUNT * ( MAX_TIME_BITS - SUB_BUCKET_BITS + 1 );
+
+	public:
+		void record( uint64 time );
+		void clear();
+
+		/*
+		 * Add the counts of the other histogram to this one.
+		 */
+		void add( const TimeHistogram& other );
+		/*
+		 * Remove the counts of the other histogram from this one,
+		 * which must have been previously added.
+		 */
+		void subtract( const TimeHistogram& other );
+
+		/*
+		 * Returns the duration, in milliseconds, under which the given
+		 * percentile of the recorded durations lies.
+		 */
+		float get_percentile( float percentile ) const;
+
+		uint32 get_count() const { return _count; }
+
+	private:
+		static int _get_bucket_index( uint64 time );
+		/*
+		 * Returns the middle duration of the bucket, in nanoseconds.
+		 */
+		static uint64 _get_bucket_time( int index );
+
+	private:
+		std::array<uint32, BUCKETS_COUNT> _buckets {};
+		uint32 _count = 0;
+	};
+
+	/*
+	 * Time histogram over a sliding window of frames, in fixed memory.
+	 *
+	 * The window is split in SLOTS_COUNT slots of 'frames_per_slot' frames.
+	 * Once a slot is full, the oldest one is removed from the window and
+	 * reused, so the window spans between 'SLOTS_COUNT - 1' and 
+	 * 'SLOTS_COUNT' slots of frames.
+	 */
+	class SlidingTimeHistogram
+	{
+	public:
+		static constexpr int SLOTS_COUNT = 4;
+
+	public:
+		SlidingTimeHistogram( int frames_per_slot = 60 );
+
+		void record( uint64 time );
+		/*
+		 * Mark the end of a frame, sliding the window when needed.
+		 */
+		void end_frame();
+		void clear();
+
+		/*
+		 * Returns the duration, in milliseconds, under which the given
+		 * percentile of the durations recorded in the window lies.
+		 */
+		float get_percentile( float percentile ) const { return _window.get_percentile( percentile ); }
+		/*
+		 * Returns the amount of durations recorded in the window.
+		 */
+		uint32 get_count() const { return _window.get_count(); }
+
+	private:
+		std::array<TimeHistogram, SLOTS_COUNT> _slots {};
+		TimeHistogram _window {};
+
+		int _frames_per_slot = 0;
+		int _current_slot = 0;
+		int _current_slot_frames = 0;
+	};
+}
@@ -0,0 +1,577 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define SUPRENGINE_FLAT_HASH_MAP_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace suprengine
+{
+	/*
+	 * Default hasher of FlatHashMap keys.
+	 */
+	template <typename T>
+	struct FlatHash : std::hash<T> {};
+
+	/*
+	 * Strings are hashed as string views, so a map with string keys can be
+	 * searched from a 'const char*' or a 'std::string_view' without
+	 * constructing a temporary string.
+	 */
+	template <>
+	struct FlatHash<std::string>
+	{
+		using is_transparent = void;
+
+		std::size_t operator()( const std::string_view value ) const
+		{
+			return std::hash<std::string_view> {}( value );
+		}
+	};
+
+	/*
+	 * Hash map storing its elements inline in a single open-addressing
+	 * table, in the manner of Abseil's SwissTable.
+	 *
+	 * Each slot has a control byte holding either its state (empty or
+	 * deleted) or 7 bits of the hash of its key. Slots are probed by groups
+	 * of 16, whose control bytes are all compared at once with SSE2, so a
+	 * lookup mostly touches a single cache line of control bytes and a
+	 * single key.
+	 *
+	 * Contrary to 'std::unordered_map', inserting may move elements and so
+	 * invalidates iterators, pointers and references to them. Iteration
+	 * order is unspecified.
+	 *
+	 * Lookups accept any key type supported by both the hasher and the
+	 * equality comparator when they are transparent.
+	 */
+	template <
+		typename Key, typename Value,
+		typename Hash = FlatHash<Key>,
+		typename Equal = std::equal_to<>
+	>
+	class FlatHashMap
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = std::size_t;
+		using hasher = Hash;
+		using key_equal = Equal;
+
+		static constexpr size_type GROUP_SIZE = 16;
+
+	private:
+		using ControlByte = signed char;
+
+		static constexpr ControlByte EMPTY = -128;
+		static constexpr ControlByte DELETED = -2;
+
+		static constexpr size_type NPOS = static_cast<size_type>( -1 );
+
+		template <typename K>
+		static constexpr bool IS_LOOKUP_KEY_V = std::is_same_v<std::decay_t<K>, Key>
+			|| ( requires { typename Hash::is_transparent; typename Equal::is_transparent; } );
+
+	public:
+		template <bool IsConst>
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = FlatHashMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+			using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+		public:
+			Iterator() = default;
+			/*
+			 * Allow conversion from a non-const iterator to a const one.
+			 */
+			template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+			Iterator( const Iterator<OtherIsConst>& other )
+				: _control( other._control ), _slot( other._slot ), _end( other._end ) {}
+
+			reference operator*() const { return *_slot; }
+			pointer operator->() const { return _slot; }
+
+			Iterator& operator++()
+			{
+				_control++;
+				_slot++;
+				_skip_free_slots();
+				return *this;
+			}
+			Iterator operator++( int )
+			{
+				Iterator copy = *this;
+				++*this;
+				return copy;
+			}
+
+			bool operator==( const Iterator& other ) const { return _control == other._control; }
+			bool operator!=( const Iterator& other ) const { return _control != other._control; }
+
+		private:
+			Iterator( const ControlByte* control, pointer slot, const ControlByte* end )
+				: _control( control ), _slot( slot ), _end( end )
+			{
+				_skip_free_slots();
+			}
+
+			void _skip_free_slots()
+			{
+				while ( _control != _end && *_control < 0 )
+				{
+					_control++;
+					_slot++;
+				}
+			}
+
+		private:
+			const ControlByte* _control = nullptr;
+			pointer _slot = nullptr;
+			const ControlByte* _end = nullptr;
+
+			template <bool>
+			friend class Iterator;
+			friend class FlatHashMap;
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+	public:
+		FlatHashMap() = default;
+		FlatHashMap( std::initializer_list<value_type> list )
+		{
+			reserve( list.size() );
+			for ( const value_type& pair : list )
+			{
+				try_emplace( pair.first, pair.second );
+			}
+		}
+		FlatHashMap( const FlatHashMap& other )
+		{
+			*this = other;
+		}
+		FlatHashMap( FlatHashMap&& other ) noexcept
+		{
+			*this = std::move( other );
+		}
+		~FlatHashMap()
+		{
+			_destroy();
+		}
+
+		FlatHashMap& operator=( const FlatHashMap& other )
+		{
+			if ( this == &other ) return *this;
+
+			clear();
+			reserve( other._size );
+			for ( const value_type& pair : other )
+			{
+				try_emplace( pair.first, pair.second );
+			}
+			return *this;
+		}
+		FlatHashMap& operator=( FlatHashMap&& other ) noexcept
+		{
+			if ( this == &other ) return *this;
+
+			_destroy();
+			_controls = std::exchange( other._controls, nullptr );
+			_slots = std::exchange( other._slots, nullptr );
+			_capacity = std::exchange( other._capacity, 0 );
+			_size = std::exchange( other._size, 0 );
+			_growth_left = std::exchange( other._growth_left, 0 );
+			return *this;
+		}
+
+		iterator begin() { return iterator( _controls, _slots, _controls + _capacity ); }
+		iterator end() { return iterator( _controls + _capacity, _slots + _capacity, _controls + _capacity ); }
+		const_iterator begin() const { return const_iterator( _controls, _slots, _controls + _capacity ); }
+		const_iterator end() const { return const_iterator( _controls + _capacity, _slots + _capacity, _controls + _capacity ); }
+
+		template <typename K, typename = std::enable_if_t<IS_LOOKUP_KEY_V<K>>>
+		iterator find( const K& key )
+		{
+			const size_type index = _find_index( key, _hash( key ) );
+			if ( index == NPOS ) return end();
+
+			return _make_iterator( index );
+		}
+		template <typename K, typename = std::enable_if_t<IS_LOOKUP_KEY_V<K>>>
+		const_iterator find( const K& key ) const
+		{
+			return const_cast<FlatHashMap*>( this )->find( key );
+		}
+		template <typename K, typename = std::enable_if_t<IS_LOOKUP_KEY_V<K>>>
+		bool contains( const K& key ) const
+		{
+			return _find_index( key, _hash( key ) ) != NPOS;
+		}
+		template <typename K, typename = std::enable_if_t<IS_LOOKUP_KEY_V<K>>>
+		size_type count( const K& key ) const
+		{
+			return contains( key ) ? 1 : 0;
+		}
+
+		/*
+		 * Insert an element constructed in-place from the arguments if the key
+		 * isn't already present. The key is only converted to the key type
+		 * when inserted.
+		 */
+		template <typename K, typename ...TArgs>
+		std::pair<iterator, bool> try_emplace( K&& key, TArgs&& ...args )
+		{
+			const uint64 hash = _hash( key );
+			size_type index = _find_index( key, hash );
+			if ( index != NPOS ) return { _make_iterator( index ), false };
+
+			index = _prepare_insert( hash );
+			new ( &_slots[index] ) value_type(
+				std::piecewise_construct,
+				std::forward_as_tuple( std::forward<K>( key ) ),
+				std::forward_as_tuple( std::forward<TArgs>( args )... )
+			);
+			return { _make_iterator( index ), true };
+		}
+		template <typename K, typename ...TArgs>
+		std::pair<iterator, bool> emplace( K&& key, TArgs&& ...args )
+		{
+			return try_emplace( std::forward<K>( key ), std::forward<TArgs>( args )... );
+		}
+		std::pair<iterator, bool> insert( const value_type& pair )
+		{
+			return try_emplace( pair.first, pair.second );
+		}
+		template <typename K, typename V>
+		std::pair<iterator, bool> insert_or_assign( K&& key, V&& value )
+		{
+			auto result = try_emplace( std::forward<K>( key ), std::forward<V>( value ) );
+			if ( !result.second )
+			{
+				result.first->second = std::forward<V>( value );
+			}
+			return result;
+		}
+
+		template <typename K>
+		Value& operator[]( K&& key )
+		{
+			return try_emplace( std::forward<K>( key ) ).first->second;
+		}
+
+		template <typename K, typename = std::enable_if_t<IS_LOOKUP_KEY_V<K>>>
+		size_type erase( const K& key )
+		{
+			const size_type index = _find_index( key, _hash( key ) );
+			if ( index == NPOS ) return 0;
+
+			_erase_index( index );
+			return 1;
+		}
+		/*
+		 * Erase the element pointed by the iterator, returning an iterator
+		 * to the next element. Erasing doesn't move other elements.
+		 */
+		iterator erase( const_iterator itr )
+		{
+			const size_type index = static_cast<size_type>( itr._control - _controls );
+			_erase_index( index );
+			return _make_iterator( index + 1 );
+		}
+		iterator erase( iterator itr )
+		{
+			return erase( const_iterator( itr ) );
+		}
+
+		/*
+		 * Destroy all elements while keeping the allocated capacity.
+		 */
+		void clear()
+		{
+			if ( _capacity == 0 ) return;
+
+			_destroy_elements();
+			std::memset( _controls, EMPTY, _capacity );
+			_size = 0;
+			_growth_left = _get_max_load( _capacity );
+		}
+		/*
+		 * Grow the table so it can hold the given amount of elements
+		 * without rehashing.
+		 */
+		void reserve( const size_type count )
+		{
+			size_type capacity = GROUP_SIZE;
+			while ( _get_max_load( capacity ) < count )
+			{
+				capacity *= 2;
+			}
+
+			if ( capacity > _capacity )
+			{
+				_rehash( capacity );
+			}
+		}
+
+		size_type size() const { return _size; }
+		bool empty() const { return _size == 0; }
+		size_type capacity() const { return _capacity; }
+
+	private:
+		/*
+		 * Masks of a group, one bit per slot.
+		 */
+		struct GroupMasks
+		{
+			static uint32 match( const ControlByte* group, const ControlByte value )
+			{
+			#ifdef SUPRENGINE_FLAT_HASH_MAP_SSE2
+				const __m128i controls = _mm_loadu_si128( reinterpret_cast<const __m128i*>( group ) );
+				return static_cast<uint32>( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( value ), controls ) ) );
+			#else
+				uint32 mask = 0;
+				for ( size_type i = 0; i < GROUP_SIZE; i++ )
+				{
+					mask |= static_cast<uint32>( group[i] == value ) << i;
+				}
+				return mask;
+			#endif
+			}
+
+			/*
+			 * Both empty and deleted slots have their sign bit set.
+			 */
+			static uint32 match_free( const ControlByte* group )
+			{
+			#ifdef SUPRENGINE_FLAT_HASH_MAP_SSE2
+				const __m128i controls = _mm_loadu_si128( reinterpret_cast<const __m128i*>( group ) );
+				return static_cast<uint32>( _mm_movemask_epi8( controls ) );
+			#else
+				uint32 mask = 0;
+				for ( size_type i = 0; i < GROUP_SIZE; i++ )
+				{
+					mask |= static_cast<uint32>( group[i] < 0 ) << i;
+				}
+				return mask;
+			#endif
+			}
+		};
+
+	private:
+		static constexpr size_type _get_max_load( const size_type capacity )
+		{
+			return capacity - capacity / 8;
+		}
+
+		template <typename K>
+		uint64 _hash( const K& key ) const
+		{
+			//	Mix the bits since standard hashers may be the identity,
+			//	while probing relies on both low and high bits
+			uint64 hash = static_cast<uint64>( _hasher( key ) );
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+		static ControlByte _get_hash_tag( const uint64 hash )
+		{
+			return static_cast<ControlByte>( hash & 0x7F );
+		}
+		size_type _get_first_group( const uint64 hash ) const
+		{
+			return static_cast<size_type>( hash >> 7 ) & ( _capacity / GROUP_SIZE - 1 );
+		}
+
+		iterator _make_iterator( const size_type index )
+		{
+			return iterator( _controls + index, _slots + index, _controls + _capacity );
+		}
+
+		template <typename K>
+		size_type _find_index( const K& key, const uint64 hash ) const
+		{
+			if ( _size == 0 ) return NPOS;
+
+			const ControlByte tag = _get_hash_tag( hash );
+			const size_type groups_mask = _capacity / GROUP_SIZE - 1;
+
+			//	Probe groups in triangular steps, which visits each group
+			//	once since the groups count is a power of two
+			size_type group = _get_first_group( hash );
+			for ( size_type step = 1; ; step++ )
+			{
+				const ControlByte* controls = _controls + group * GROUP_SIZE;
+				for ( uint32 mask = GroupMasks::match( controls, tag ); mask != 0; mask &= mask - 1 )
+				{
+					const size_type index = group * GROUP_SIZE + std::countr_zero( mask );
+					if ( _equal( _slots[index].first, key ) ) return index;
+				}
+
+				//	An empty slot ends the probing: the key would have been inserted there
+				if ( GroupMasks::match( controls, EMPTY ) != 0 ) return NPOS;
+
+				group = ( group + step ) & groups_mask;
+			}
+		}
+
+		/*
+		 * Find a free slot for a new element of given hash, growing the table
+		 * if needed, and mark it as used.
+		 */
+		size_type _prepare_insert( const uint64 hash )
+		{
+			if ( _growth_left == 0 )
+			{
+				//	Rehash in place when most of the load is made of deleted slots
+				const size_type capacity = _capacity == 0 ? GROUP_SIZE
+					: _size < _get_max_load( _capacity ) / 2 ? _capacity : _capacity * 2;
+				_rehash( capacity );
+			}
+
+			const size_type index = _find_free_index( hash );
+			if ( _controls[index] == EMPTY )
+			{
+				_growth_left--;
+			}
+			_controls[index] = _get_hash_tag( hash );
+			_size++;
+			return index;
+		}
+		size_type _find_free_index( const uint64 hash ) const
+		{
+			const size_type groups_mask = _capacity / GROUP_SIZE - 1;
+
+			size_type group = _get_first_group( hash );
+			for ( size_type step = 1; ; step++ )
+			{
+				const uint32 mask = GroupMasks::match_free( _controls + group * GROUP_SIZE );
+				if ( mask != 0 ) return group * GROUP_SIZE + std::countr_zero( mask );
+
+				group = ( group + step ) & groups_mask;
+			}
+		}
+
+		void _erase_index( const size_type index )
+		{
+			_slots[index].~value_type();
+			_size--;
+
+			//	A group with an empty slot never made a probing continue further,
+			//	so the slot can be emptied, otherwise it must be kept as deleted
+			const ControlByte* group = _controls + ( index / GROUP_SIZE ) * GROUP_SIZE;
+			if ( GroupMasks::match( group, EMPTY ) != 0 )
+			{
+				_controls[index] = EMPTY;
+				_growth_left++;
+			}
+			else
+			{
+				_controls[index] = DELETED;
+			}
+		}
+
+		void _rehash( const size_type capacity )
+		{
+			ControlByte* old_controls = _controls;
+			value_type* old_slots = _slots;
+			const size_type old_capacity = _capacity;
+
+			//	Allocate control bytes and slots in a single block
+			static_assert( alignof( value_type ) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+				"FlatHashMap doesn't support over-aligned elements" );
+			const size_type slots_offset = _get_slots_offset( capacity );
+			char* memory = static_cast<char*>( ::operator new( slots_offset + capacity * sizeof( value_type ) ) );
+			_controls = reinterpret_cast<ControlByte*>( memory );
+			_slots = reinterpret_cast<value_type*>( memory + slots_offset );
+			_capacity = capacity;
+			_growth_left = _get_max_load( capacity ) - _size;
+			std::memset( _controls, EMPTY, capacity );
+
+			//	Move elements into their new slots, keys are copied since
+			//	they are const
+			for ( size_type i = 0; i < old_capacity; i++ )
+			{
+				if ( old_controls[i] < 0 ) continue;
+
+				value_type& pair = old_slots[i];
+				const uint64 hash = _hash( pair.first );
+				const size_type index = _find_free_index( hash );
+				_controls[index] = _get_hash_tag( hash );
+				new ( &_slots[index] ) value_type( std::move( pair ) );
+				pair.~value_type();
+			}
+
+			if ( old_controls != nullptr )
+			{
+				::operator delete( old_controls );
+			}
+		}
+
+		static size_type _get_slots_offset( const size_type capacity )
+		{
+			return ( capacity + alignof( value_type ) - 1 ) / alignof( value_type ) * alignof( value_type );
+		}
+
+		void _destroy_elements()
+		{
+			if constexpr ( std::is_trivially_destructible_v<value_type> ) return;
+
+			for ( size_type i = 0; i < _capacity; i++ )
+			{
+				if ( _controls[i] < 0 ) continue;
+
+				_slots[i].~value_type();
+			}
+		}
+		void _destroy()
+		{
+			if ( _controls == nullptr ) return;
+
+			_destroy_elements();
+			::operator delete( _controls );
+			_controls = nullptr;
+			_slots = nullptr;
+			_capacity = 0;
+			_size = 0;
+			_growth_left = 0;
+		}
+
+	private:
+		ControlByte* _controls = nullptr;
+		value_type* _slots = nullptr;
+		size_type _capacity = 0;
+		size_type _size = 0;
+		/*
+		 * Amount of empty slots which can still be used before reaching
+		 * the maximum load factor of 7/8.
+		 */
+		size_type _growth_left = 0;
+
+		Hash _hasher {};
+		Equal _equal {};
+	};
+}
@@ -0,0 +1,94 @@
+#include "frame-arena.h"
+
+#include <suprengine/tools/memory-profiler.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace suprengine;
+
+FrameArena::FrameArena( const char* name, const std::size_t capacity )
+	: _name( name ), _capacity( ( capacity + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT )
+{
+	static_assert( ALIGNMENT <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "The buffer alignment can't be guaranteed by malloc!" );
+
+	_buffer = static_cast<char*>( std::malloc( _capacity ) );
+	if ( _buffer == nullptr ) throw std::bad_alloc();
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::register_allocation( _name, _capacity );
+#endif
+}
+
+FrameArena::~FrameArena()
+{
+	_release_overflow_allocations();
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::register_deallocation( _name, _capacity );
+#endif
+	std::free( _buffer );
+}
+
+void* FrameArena::allocate( std::size_t bytes, std::size_t alignment )
+{
+	ASSERT( ( alignment & ( alignment - 1 ) ) == 0 );
+	alignment = std::max( alignment, ALIGNMENT );
+
+	//	Keep offsets aligned, reserving room to align the pointer further
+	bytes = ( std::max( bytes, std::size_t { 1 } ) + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+	const std::size_t reserved_bytes = bytes + alignment - ALIGNMENT;
+
+	const std::size_t offset = _offset.fetch_add( reserved_bytes, std::memory_order_relaxed );
+	if ( offset + reserved_bytes <= _capacity )
+	{
+		const std::size_t aligned_offset = ( offset + alignment - 1 ) / alignment * alignment;
+		return _buffer + aligned_offset;
+	}
+
+	//	Fall back to the heap until the next reset
+	void* pointer = ::operator new( bytes, std::align_val_t { alignment } );
+	_overflow_bytes.fetch_add( bytes, std::memory_order_relaxed );
+
+	std::lock_guard lock( _overflow_mutex );
+	_overflow_allocations.push_back( OverflowAllocation { pointer, alignment } );
+	return pointer;
+}
+
+void FrameArena::reset()
+{
+	const std::size_t used_bytes = std::min( _offset.load( std::memory_order_relaxed ), _capacity );
+	const std::size_t overflow_bytes = _overflow_bytes.load( std::memory_order_relaxed );
+	_high_water_mark = std::max( _high_water_mark, used_bytes + overflow_bytes );
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::register_arena_usage( _name, _capacity, used_bytes + overflow_bytes, overflow_bytes );
+#endif
+
+#ifndef NDEBUG
+	std::memset( _buffer, POISON_BYTE, used_bytes );
+#endif
+
+	_release_overflow_allocations();
+	_offset.store( 0, std::memory_order_relaxed );
+}
+
+std::size_t FrameArena::get_used_bytes() const
+{
+	return std::min( _offset.load( std::memory_order_relaxed ), _capacity )
+		+ _overflow_bytes.load( std::memory_order_relaxed );
+}
+
+void FrameArena::_release_overflow_allocations()
+{
+	for ( const OverflowAllocation& allocation : _overflow_allocations )
+	{
+		::operator delete( allocation.pointer, std::align_val_t { allocation.alignment } );
+	}
+	_overflow_allocations.clear();
+	_overflow_bytes.store( 0, std::memory_order_relaxed );
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace suprengine
+{
+	/*
+	 * Linear allocator for memory only living until the end of the frame.
+	 *
+	 * Allocations are bumped from a fixed buffer and all released at once
+	 * by a reset, which the engine does at the start of each frame. Once
+	 * the buffer is exhausted, allocations fall back to the heap until the
+	 * next reset. 
+	 * 
+	 * Usage, high-water mark and overflow are reported to the 
+	 * MemoryProfiler on reset, and released memory is poisoned in debug
+	 * builds to catch allocations outliving their frame.
+	 *
+	 * Allocating is thread-safe, resetting isn't.
+	 */
+	class FrameArena
+	{
+	public:
+		static constexpr std::size_t ALIGNMENT = 16;
+		/*
+		 * Byte written over released memory in debug builds.
+		 */
+		static constexpr unsigned char POISON_BYTE = 0xCD;
+
+	public:
+		FrameArena( const char* name, std::size_t capacity );
+		~FrameArena();
+		FrameArena( const FrameArena& ) = delete;
+		FrameArena& operator=( const FrameArena& ) = delete;
+
+		void* allocate( std::size_t bytes, std::size_t alignment = ALIGNMENT );
+		/*
+		 * Release all allocations at once.
+		 * No allocation must happen meanwhile.
+		 */
+		void reset();
+
+		const char* get_name() const { return _name; }
+		std::size_t get_capacity() const { return _capacity; }
+		/*
+		 * Returns the amount of bytes allocated since the last reset,
+		 * including overflowing ones.
+		 */
+		std::size_t get_used_bytes() const;
+		/*
+		 * Returns the maximum amount of bytes allocated between two resets.
+		 */
+		std::size_t get_high_water_mark() const { return _high_water_mark; }
+
+	private:
+		struct OverflowAllocation
+		{
+			void* pointer = nullptr;
+			std::size_t alignment = 0;
+		};
+
+	private:
+		void _release_overflow_allocations();
+
+	private:
+		const char* _name = nullptr;
+
+		char* _buffer = nullptr;
+		std::size_t _capacity = 0;
+		std::atomic<std::size_t> _offset { 0 };
+		std::size_t _high_water_mark = 0;
+
+		std::mutex _overflow_mutex {};
+		std::vector<OverflowAllocation> _overflow_allocations {};
+		std::atomic<std::size_t> _overflow_bytes { 0 };
+	};
+
+	/*
+	 * STL allocator adaptor over a FrameArena, for temporary containers.
+	 * Deallocations are no-ops, memory being released by the arena reset.
+	 */
+	template <typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		FrameStlAllocator( FrameArena* arena )
+			: arena( arena ) {}
+		template <typename U>
+		FrameStlAllocator( const FrameStlAllocator<U>& other )
+			: arena( other.arena ) {}
+
+		T* allocate( const std::size_t count )
+		{
+			return static_cast<T*>( arena->allocate( count * sizeof( T ), alignof( T ) ) );
+		}
+		void deallocate( T*, const std::size_t ) {}
+
+		template <typename U>
+		bool operator==( const FrameStlAllocator<U>& other ) const { return arena == other.arena; }
+		template <typename U>
+		bool operator!=( const FrameStlAllocator<U>& other ) const { return arena != other.arena; }
+
+	public:
+		FrameArena* arena = nullptr;
+	};
+
+	template <typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+}
@@ -0,0 +1,207 @@
+#include "pool-allocator.h"
+
+#include <suprengine/tools/memory-profiler.h>
+
+#include <suprengine/utils/assert.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+using namespace suprengine;
+
+struct FreeBlock
+{
+	FreeBlock* next = nullptr;
+};
+
+/*
+ * Stored at the start of each page, which is aligned on its size so
+ * the page of any block is found by masking the block address.
+ */
+struct PageHeader
+{
+	std::size_t live_blocks = 0;
+};
+
+static constexpr std::size_t PAGE_HEADER_SIZE = PoolAllocator::GRANULARITY;
+static_assert( sizeof( PageHeader ) <= PAGE_HEADER_SIZE );
+
+struct SizeClass
+{
+	std::mutex mutex {};
+
+	FreeBlock* free_list = nullptr;
+	std::vector<void*> pages {};
+
+	std::size_t live_blocks = 0;
+};
+
+static SizeClass size_classes[PoolAllocator::SIZE_CLASSES_COUNT] {};
+
+static std::size_t get_size_class_index( const std::size_t bytes )
+{
+	return ( bytes + PoolAllocator::GRANULARITY - 1 ) / PoolAllocator::GRANULARITY - 1;
+}
+
+static std::size_t get_block_size( const std::size_t size_class_index )
+{
+	return ( size_class_index + 1 ) * PoolAllocator::GRANULARITY;
+}
+
+static std::size_t get_page_blocks_count( const std::size_t block_size )
+{
+	return ( PoolAllocator::PAGE_SIZE - PAGE_HEADER_SIZE ) / block_size;
+}
+
+static PageHeader* get_page_header( void* block )
+{
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>( block );
+	return reinterpret_cast<PageHeader*>( address & ~( PoolAllocator::PAGE_SIZE - 1 ) );
+}
+
+/*
+ * Link all blocks of the page in order, in front of the free list.
+ */
+static void link_page_blocks( SizeClass& size_class, char* page, const std::size_t block_size )
+{
+	char* blocks = page + PAGE_HEADER_SIZE;
+	for ( std::size_t i = get_page_blocks_count( block_size ); i > 0; i-- )
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>( blocks + ( i - 1 ) * block_size );
+		block->next = size_class.free_list;
+		size_class.free_list = block;
+	}
+}
+
+void* PoolAllocator::allocate( const char* category, std::size_t bytes )
+{
+	if ( bytes == 0 )
+	{
+		bytes = 1;
+	}
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::register_allocation( category, bytes );
+#endif
+
+	if ( bytes > MAX_BLOCK_SIZE )
+	{
+		void* pointer = std::malloc( bytes );
+		if ( pointer == nullptr ) throw std::bad_alloc();
+
+		return pointer;
+	}
+
+	const std::size_t size_class_index = get_size_class_index( bytes );
+	SizeClass& size_class = size_classes[size_class_index];
+	std::lock_guard lock( size_class.mutex );
+
+	//  Grow by a page
+	if ( size_class.free_list == nullptr )
+	{
+		char* page = static_cast<char*>( ::operator new( PAGE_SIZE, std::align_val_t { PAGE_SIZE } ) );
+		new ( page ) PageHeader {};
+
+		size_class.pages.push_back( page );
+		link_page_blocks( size_class, page, get_block_size( size_class_index ) );
+	}
+
+	FreeBlock* block = size_class.free_list;
+	size_class.free_list = block->next;
+	size_class.live_blocks++;
+	get_page_header( block )->live_blocks++;
+
+	return block;
+}
+
+void PoolAllocator::deallocate( const char* category, void* pointer, std::size_t bytes )
+{
+	if ( pointer == nullptr ) return;
+
+	if ( bytes == 0 )
+	{
+		bytes = 1;
+	}
+
+#ifdef ENABLE_MEMORY_PROFILER
+	MemoryProfiler::register_deallocation( category, bytes );
+#endif
+
+	if ( bytes > MAX_BLOCK_SIZE )
+	{
+		std::free( pointer );
+		return;
+	}
+
+	SizeClass& size_class = size_classes[get_size_class_index( bytes )];
+	std::lock_guard lock( size_class.mutex );
+
+	FreeBlock* block = static_cast<FreeBlock*>( pointer );
+	block->next = size_class.free_list;
+	size_class.free_list = block;
+
+	ASSERT( size_class.live_blocks > 0 );
+	size_class.live_blocks--;
+
+	PageHeader* page = get_page_header( block );
+	ASSERT( page->live_blocks > 0 );
+	page->live_blocks--;
+}
+
+void PoolAllocator::reset()
+{
+	for ( SizeClass& size_class : size_classes )
+	{
+		std::lock_guard lock( size_class.mutex );
+
+		const auto is_page_unused = []( void* page )
+		{
+			return static_cast<PageHeader*>( page )->live_blocks == 0;
+		};
+		if ( std::none_of( size_class.pages.begin(), size_class.pages.end(), is_page_unused ) ) continue;
+
+		//  Unlink the blocks of unused pages, keeping the order of the others
+		FreeBlock** link = &size_class.free_list;
+		while ( *link != nullptr )
+		{
+			if ( get_page_header( *link )->live_blocks == 0 )
+			{
+				*link = ( *link )->next;
+			}
+			else
+			{
+				link = &( *link )->next;
+			}
+		}
+
+		//  Release unused pages
+		const auto itr = std::remove_if( size_class.pages.begin(), size_class.pages.end(),
+			[&]( void* page )
+			{
+				if ( !is_page_unused( page ) ) return false;
+
+				::operator delete( page, std::align_val_t { PAGE_SIZE } );
+				return true;
+			}
+		);
+		size_class.pages.erase( itr, size_class.pages.end() );
+	}
+}
+
+PoolSizeClassStats PoolAllocator::get_size_class_stats( const std::size_t size_class_index )
+{
+	SizeClass& size_class = size_classes[size_class_index];
+	std::lock_guard lock( size_class.mutex );
+
+	const std::size_t block_size = get_block_size( size_class_index );
+
+	PoolSizeClassStats stats {};
+	stats.block_size = block_size;
+	stats.pages_count = size_class.pages.size();
+	stats.capacity = size_class.pages.size() * get_page_blocks_count( block_size );
+	stats.live_blocks = size_class.live_blocks;
+	return stats;
+}
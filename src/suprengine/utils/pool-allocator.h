@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace suprengine
+{
+	struct PoolSizeClassStats
+	{
+		std::size_t block_size = 0;
+		std::size_t pages_count = 0;
+		std::size_t capacity = 0;
+		std::size_t live_blocks = 0;
+	};
+
+	/*
+	 * Size-class pool allocator, used for entities and components.
+	 *
+	 * Requests are rounded up to a multiple of GRANULARITY and served from
+	 * the matching size class, which hands out fixed-size blocks from pages
+	 * through an intrusive free list. Each page counts its live blocks so
+	 * 'reset' can release the unused ones. Requests larger than
+	 * MAX_BLOCK_SIZE fall back to malloc.
+	 *
+	 * Allocations are reported to the MemoryProfiler under the given category.
+	 * Thread-safe.
+	 */
+	class PoolAllocator
+	{
+	public:
+		static constexpr std::size_t GRANULARITY = 16;
+		static constexpr std::size_t MAX_BLOCK_SIZE = 512;
+		static constexpr std::size_t SIZE_CLASSES_COUNT = MAX_BLOCK_SIZE / GRANULARITY;
+		static constexpr std::size_t PAGE_SIZE = 64 * 1024;
+
+	public:
+		static void* allocate( const char* category, std::size_t bytes );
+		static void deallocate( const char* category, void* pointer, std::size_t bytes );
+
+		/*
+		 * Release the pages without live blocks back to the system.
+		 * Pages are otherwise kept once allocated, so pools only grow
+		 * in between resets.
+		 * Called by the engine when clearing its entities.
+		 */
+		static void reset();
+
+		static PoolSizeClassStats get_size_class_stats( std::size_t size_class_index );
+	};
+
+	/*
+	 * STL allocator adaptor over the PoolAllocator, notably allowing
+	 * std::allocate_shared to allocate the control block alongside
+	 * the object.
+	 */
+	template <typename T>
+	class PoolStlAllocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		PoolStlAllocator( const char* category )
+			: category( category ) {}
+		template <typename U>
+		PoolStlAllocator( const PoolStlAllocator<U>& other )
+			: category( other.category ) {}
+
+		T* allocate( const std::size_t count )
+		{
+			static_assert( alignof( T ) <= PoolAllocator::GRANULARITY, "Over-aligned types aren't supported by the pool allocator!" );
+			return static_cast<T*>( PoolAllocator::allocate( category, count * sizeof( T ) ) );
+		}
+		void deallocate( T* pointer, const std::size_t count )
+		{
+			PoolAllocator::deallocate( category, pointer, count * sizeof( T ) );
+		}
+
+		template <typename U>
+		bool operator==( const PoolStlAllocator<U>& other ) const { return category == other.category; }
+		template <typename U>
+		bool operator!=( const PoolStlAllocator<U>& other ) const { return category != other.category; }
+
+	public:
+		const char* category = nullptr;
+	};
+}
@@ -16,6 +16,12 @@ namespace suprengine
 	 * Internally using STL's smart pointers and especially 
 	 * inheriting std::weak_ptr to handle validity and storage of 
 	 * the underlying object.
+	 * 
+	 * The pointer is valid for as long as the object is alive. Entities
+	 * use a specialization, in entity-handle.h, which is also invalid
+	 * once the entity is removed from the engine, even if still owned
+	 * elsewhere. Once the entity is added to the engine, its validity
+	 * is checked in constant time through its handle.
 	 */
 	template<typename T>
 	class SafePtr : public std::weak_ptr<T>
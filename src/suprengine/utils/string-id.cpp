@@ -0,0 +1,89 @@
+#include "string-id.h"
+
+#include <suprengine/utils/flat-hash-map.h>
+#include <suprengine/utils/logger.h>
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace suprengine;
+
+struct InternTable
+{
+	std::mutex mutex {};
+
+	FlatHashMap<StringId, const char*> strings {};
+	/*
+	 * Owns the interned strings, which must never move.
+	 */
+	std::vector<std::unique_ptr<char[]>> storage {};
+};
+
+/*
+ * Constructed on first use, as identifiers may be interned during
+ * static initialization.
+ */
+static InternTable& get_intern_table()
+{
+	static InternTable table {};
+	return table;
+}
+
+/*
+ * Returns the interned copy of the string.
+ */
+static const char* intern_string( const StringId id, const std::string_view string )
+{
+	InternTable& table = get_intern_table();
+	std::lock_guard lock( table.mutex );
+
+	const auto itr = table.strings.find( id );
+	if ( itr != table.strings.end() )
+	{
+		if ( string != itr->second )
+		{
+			Logger::error(
+				"StringId: hash collision between '%s' and '%.*s'!",
+				itr->second, static_cast<int>( string.size() ), string.data()
+			);
+		}
+		return itr->second;
+	}
+
+	char* copy = new char[string.size() + 1];
+	std::memcpy( copy, string.data(), string.size() );
+	copy[string.size()] = '\0';
+
+	table.storage.emplace_back( copy );
+	table.strings.emplace( id, copy );
+	return copy;
+}
+
+StringId StringId::intern( const std::string_view string )
+{
+	StringId id {};
+	id._hash = hash( string );
+#ifndef NDEBUG
+	id._debug_string = intern_string( id, string );
+#else
+	intern_string( id, string );
+#endif
+	return id;
+}
+
+const char* StringId::get_string() const
+{
+#ifndef NDEBUG
+	if ( _debug_string != nullptr ) return _debug_string;
+#endif
+
+	InternTable& table = get_intern_table();
+	std::lock_guard lock( table.mutex );
+
+	const auto itr = table.strings.find( *this );
+	if ( itr == table.strings.end() ) return "<unknown>";
+
+	return itr->second;
+}
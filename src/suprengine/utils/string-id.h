@@ -0,0 +1,104 @@
+#pragma once
+
+#include <suprengine/utils/usings.h>
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace suprengine
+{
+	/*
+	 * Identifier of a string by its 64-bit FNV-1a hash, so names can be
+	 * compared and looked up as integers.
+	 *
+	 * Identifiers of string literals are hashed at compile time, and
+	 * runtime strings are hashed on construction without any lookup.
+	 * Registries intern the names they store with 'intern', in a global
+	 * table allowing their identifiers to be turned back into strings.
+	 */
+	class StringId
+	{
+	public:
+		/*
+		 * Construct an invalid identifier, matching no string.
+		 */
+		constexpr StringId() = default;
+		/*
+		 * Construct from a string literal, hashed at compile time.
+		 * Runtime character buffers must be passed as 'std::string_view'.
+		 */
+		template <std::size_t N>
+		consteval StringId( const char ( &string )[N] )
+			: _hash( hash( std::string_view( string, N - 1 ) ) )
+		#ifndef NDEBUG
+			, _debug_string( string )
+		#endif
+		{}
+		/*
+		 * Construct from a runtime C string.
+		 */
+		template <typename T>
+			requires std::is_same_v<T, const char*> || std::is_same_v<T, char*>
+		StringId( const T& string )
+			: StringId( std::string_view( string ) ) {}
+		StringId( const std::string& string )
+			: StringId( std::string_view( string ) ) {}
+		constexpr explicit StringId( const std::string_view string )
+			: _hash( hash( string ) ) {}
+
+		/*
+		 * Construct from a runtime string and store it in the intern table,
+		 * for 'get_string' to find it back. It locks the table, so it's
+		 * meant for registration rather than lookups.
+		 */
+		static StringId intern( std::string_view string );
+
+		static constexpr uint64 hash( const std::string_view string )
+		{
+			uint64 hash = 0xCBF29CE484222325ull;
+			for ( const char character : string )
+			{
+				hash ^= static_cast<uint8>( character );
+				hash *= 0x00000100000001B3ull;
+			}
+			return hash;
+		}
+
+		/*
+		 * Returns the string this identifier was constructed from if it
+		 * has been interned, or "<unknown>" otherwise. In debug builds,
+		 * identifiers of string literals also keep their string.
+		 * The string lives until the end of the program.
+		 */
+		const char* get_string() const;
+
+		constexpr uint64 get_hash() const { return _hash; }
+		constexpr bool is_valid() const { return _hash != 0; }
+
+		constexpr bool operator==( const StringId& other ) const { return _hash == other._hash; }
+		constexpr auto operator<=>( const StringId& other ) const { return _hash <=> other._hash; }
+
+	private:
+		uint64 _hash = 0;
+	#ifndef NDEBUG
+		/*
+		 * String of literal and interned identifiers, so names of failed
+		 * lookups can be printed.
+		 */
+		const char* _debug_string = nullptr;
+	#endif
+	};
+}
+
+template <>
+struct std::hash<suprengine::StringId>
+{
+	std::size_t operator()( const suprengine::StringId id ) const
+	{
+		return static_cast<std::size_t>( id.get_hash() );
+	}
+};
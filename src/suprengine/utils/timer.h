@@ -1,11 +1,15 @@
 #pragma once
 
+#include <suprengine/utils/usings.h>
+
 #include <functional>
 
 #define TIMER( time, code )  Engine::instance().add_timer( Timer( [&]() { code }, time ) )
 
 namespace suprengine
 {
+	class TimerWheel;
+
 	using lambda = std::function<void()>;
 	struct Timer
 	{
@@ -32,11 +36,44 @@ namespace suprengine
 		 * Timer's function to call once the time is depleted.
 		 */
 		lambda callback;
+	};
+
+	/*
+	 * Handle to a timer added to a TimerWheel.
+	 * It becomes invalid once the timer has run all its repetitions
+	 * or has been cancelled.
+	 */
+	class TimerHandle
+	{
+	public:
+		TimerHandle() = default;
+		TimerHandle( TimerWheel* wheel, uint32 index, uint32 generation )
+			: _wheel( wheel ), _index( index ), _generation( generation ) {}
+
+		bool is_valid() const;
+		bool is_paused() const;
+		/*
+		 * Returns the time in seconds before the next call.
+		 */
+		float get_remaining_time() const;
 
 		/*
-		 * Timer's current time.
-		 * Once it exceeded the maximum time, the callback is called.
+		 * Remove the timer without calling its callback.
+		 */
+		void cancel();
+		void pause();
+		void resume();
+		/*
+		 * Restart the timer with a new time, keeping its remaining
+		 * repetitions. A paused timer stays paused.
 		 */
-		float current_time = 0.0f;
+		void reschedule( float time );
+
+	private:
+		TimerWheel* _wheel = nullptr;
+		uint32 _index = 0;
+		uint32 _generation = 0;
+
+		friend class TimerWheel;
 	};
-}
\ No newline at end of file
+}
@@ -2,6 +2,12 @@
 
 #include <string>
 
+/*
+ * Concatenate both tokens once expanded, e.g. to name variables after __LINE__.
+ */
+#define SUPRENGINE_CONCAT_INNER( a, b ) a##b
+#define SUPRENGINE_CONCAT( a, b ) SUPRENGINE_CONCAT_INNER( a, b )
+
 using rconst_str = const std::string&;
 
 /*